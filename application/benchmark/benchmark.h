@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <string>
+
+namespace benchmark {
+// Keeps a computed value alive so the measured loop is not optimized away.
+template <typename T>
+void Consume(const T& value) {
+  [[maybe_unused]] static volatile T sink;
+
+  sink = value;
+}
+
+// Runs the callable once and reports its throughput in operations per second.
+template <typename Callable>
+double Measure(const std::string& name, const uint64_t operations,
+               Callable&& callable) {
+  const auto start = std::chrono::steady_clock::now();
+
+  callable();
+
+  const auto end = std::chrono::steady_clock::now();
+
+  const std::chrono::duration<double> duration = end - start;
+
+  const auto rate = static_cast<double>(operations) / duration.count();
+
+  std::cout << std::format("{:<48} {:>12.3e} ops/s\n", name, rate);
+
+  return rate;
+}
+
+void Kernel(void);
+
+void Prng(void);
+
+void Route(void);
+
+void Spectrum(void);
+}  // namespace benchmark
@@ -0,0 +1,29 @@
+#include <core/configuration.h>
+#include <core/kernel.h>
+#include <test/fixture.h>
+
+#include <cstdint>
+#include <memory>
+
+#include "benchmark.h"
+
+namespace benchmark {
+constexpr double Duration = 100'000.0;
+
+constexpr double ArrivalRate = 1.0;
+
+// The whole event loop on a loaded nsfnet where every request type uses
+// first-fit, in expected arrivals per second.
+void Kernel(void) {
+  const auto configuration = fixture::Nsfnet({
+      {"arrival-rate", ArrivalRate},
+      {"requests", fixture::Requests("first-fit", "first-fit")},
+      {"simulation-duration", Duration},
+  });
+
+  core::Kernel kernel(configuration, 1u);
+
+  Measure("kernel", static_cast<uint64_t>(Duration * ArrivalRate),
+          [&]() { kernel.Run(); });
+}
+}  // namespace benchmark
@@ -0,0 +1,13 @@
+#include "benchmark.h"
+
+int main(void) {
+  benchmark::Prng();
+
+  benchmark::Route();
+
+  benchmark::Spectrum();
+
+  benchmark::Kernel();
+
+  return 0;
+}
@@ -0,0 +1,83 @@
+#include <prng/prng.h>
+
+#include <format>
+#include <vector>
+
+#include "benchmark.h"
+
+namespace benchmark {
+constexpr uint64_t Draws = 10'000'000u;
+
+template <typename T>
+void Draw(const std::string& name, const prng::Variable<T>& variable) {
+  Measure(name, Draws, [&]() {
+    auto sum = 0.0;
+
+    for (auto index = 0u; index < Draws; ++index) {
+      sum += variable.Next();
+    }
+
+    Consume(sum);
+  });
+}
+
+void Prng(void) {
+  static const std::vector<std::pair<std::string, prng::Engine::Type>> engines{
+      {"mt19937", prng::Engine::Type::MersenneTwister},
+      {"philox", prng::Engine::Type::Philox},
+      {"xoshiro", prng::Engine::Type::Xoshiro},
+  };
+
+  const std::vector<double> weights{0.5, 0.5};
+
+  // One weight per ordered node pair of a 48-node topology.
+  std::vector<double> pairs(48u * 47u);
+
+  for (auto index = 0u; index < pairs.size(); ++index) {
+    pairs[index] = 1.0 + index % 7u;
+  }
+
+  for (const auto& [engine, type] : engines) {
+    prng::PseudoRandomNumberGenerator generator(type);
+
+    generator.SetSeed(1u);
+
+    generator.SetExponentialVariable("keyed", 1.0);
+
+    Measure(std::format("{} exponential Next(key)", engine), Draws, [&]() {
+      auto sum = 0.0;
+
+      for (auto index = 0u; index < Draws; ++index) {
+        sum += generator.Next("keyed");
+      }
+
+      Consume(sum);
+    });
+
+    Draw(std::format("{} exponential handle", engine),
+         generator.SetExponentialVariable("scalar", 1.0));
+
+    Draw(std::format("{} exponential block", engine),
+         generator.SetVariable<prng::ExponentialBlock>("block", 1.0));
+
+    Draw(std::format("{} discrete handle", engine),
+         generator.SetDiscreteVariable("fsus", weights.begin(), weights.end()));
+
+    Draw(std::format("{} discrete block", engine),
+         generator.SetVariable<prng::DiscreteBlock>("fsus.block",
+                                                    weights.begin(),
+                                                    weights.end()));
+
+    Draw(std::format("{} alias", engine),
+         generator.SetVariable<prng::Alias>("fsus.alias", weights.begin(),
+                                            weights.end()));
+
+    Draw(std::format("{} discrete handle (2256 pairs)", engine),
+         generator.SetDiscreteVariable("pairs", pairs.begin(), pairs.end()));
+
+    Draw(std::format("{} alias (2256 pairs)", engine),
+         generator.SetVariable<prng::Alias>("pairs.alias", pairs.begin(),
+                                            pairs.end()));
+  }
+}
+}  // namespace benchmark
@@ -0,0 +1,182 @@
+#include <graph/bfs.h>
+#include <graph/dijkstra.h>
+#include <graph/graph.h>
+#include <graph/ksp.h>
+#include <graph/table.h>
+
+#include <prng/engine.h>
+
+#include <format>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "benchmark.h"
+
+namespace benchmark {
+constexpr uint64_t Tables = 200u;
+
+constexpr uint64_t Paths = 3u;
+
+constexpr uint64_t Queries = 1'000u;
+
+// Side of the square grid and vertex count of the random graph, both about
+// the size of a metro-scale network model.
+constexpr uint64_t Side = 256u;
+
+constexpr uint64_t Vertices = Side * Side;
+
+constexpr uint64_t Degree = 8u;
+
+// Distances in km with one decimal, as the bundled topologies have them.
+static graph::Cost Distance(prng::Engine& engine) {
+  return static_cast<double>(1u + engine.Below(10'000u)) / 10.0;
+}
+
+static graph::Graph Grid(prng::Engine& engine) {
+  std::vector<graph::Edge> edges;
+
+  for (auto row = 0u; row < Side; ++row) {
+    for (auto column = 0u; column < Side; ++column) {
+      const auto vertex = row * Side + column;
+
+      for (const auto next : {column + 1u < Side ? vertex + 1u : vertex,
+                              row + 1u < Side ? vertex + Side : vertex}) {
+        if (next == vertex) {
+          continue;
+        }
+
+        const auto distance = Distance(engine);
+
+        edges.emplace_back(vertex, next, distance);
+
+        edges.emplace_back(next, vertex, distance);
+      }
+    }
+  }
+
+  return graph::Graph(Vertices, std::move(edges));
+}
+
+static graph::Graph Random(prng::Engine& engine) {
+  std::vector<graph::Edge> edges;
+
+  for (auto vertex = 0u; vertex < Vertices; ++vertex) {
+    for (auto edge = 0u; edge < Degree; ++edge) {
+      edges.emplace_back(vertex, engine.Below(Vertices), Distance(engine));
+    }
+  }
+
+  return graph::Graph(Vertices, std::move(edges));
+}
+
+// Route tables over every ordered pair on the bundled topologies, single
+// queries on large synthetic graphs, and the k-shortest paths between every
+// pair of the bundled topologies, full meshes included.
+void Route(void) {
+  for (const std::string name : {"nsfnet", "germany-17", "jpn-48"}) {
+    const auto graph =
+        graph::Graph::from(std::format("{}/graph/{}.txt", RESOURCES, name))
+            .value();
+
+    const auto pairs = graph.size() * (graph.size() - 1u);
+
+    Measure(std::format("route dijkstra table {}", name), Tables * pairs,
+            [&]() {
+              uint64_t sum = 0u;
+
+              for (auto index = 0u; index < Tables; ++index) {
+                const graph::RouteTable table(graph, graph::Dijkstra(graph));
+
+                sum += table.path(table.at(0u, 1u)).hops();
+              }
+
+              Consume(sum);
+            });
+
+    // The startup precompute, over every core.
+    Measure(std::format("route parallel table {}", name), Tables * pairs,
+            [&]() {
+              uint64_t sum = 0u;
+
+              for (auto index = 0u; index < Tables; ++index) {
+                const graph::RouteTable table(
+                    graph, 1u, std::thread::hardware_concurrency());
+
+                sum += table.path(table.at(0u, 1u)).hops();
+              }
+
+              Consume(sum);
+            });
+
+    Measure(std::format("route bfs table {}", name), Tables * pairs, [&]() {
+      uint64_t sum = 0u;
+
+      for (auto index = 0u; index < Tables; ++index) {
+        const graph::RouteTable table(graph, graph::BreadthFirstSearch(graph));
+
+        sum += table.path(table.at(0u, 1u)).hops();
+      }
+
+      Consume(sum);
+    });
+  }
+
+  // Point-to-point queries between random pairs on large synthetic graphs.
+  prng::Engine engine(prng::Engine::Type::Philox, 0u, 0u);
+
+  for (const auto& [name, synthetic] :
+       {std::pair{"grid", Grid(engine)}, std::pair{"random", Random(engine)}}) {
+    const graph::Dijkstra dijkstra(synthetic);
+
+    std::vector<std::pair<graph::Vertex, graph::Vertex>> pairs(Queries);
+
+    for (auto& [source, destination] : pairs) {
+      source = engine.Below(Vertices);
+
+      destination = engine.Below(Vertices);
+    }
+
+    Measure(std::format("route dijkstra query {} {}", name, Vertices), Queries,
+            [&]() {
+              uint64_t sum = 0u;
+
+              for (const auto& [source, destination] : pairs) {
+                const auto route = dijkstra.compute(source, destination);
+
+                sum += route.has_value() ? route->links.size() : 0u;
+              }
+
+              Consume(sum);
+            });
+  }
+
+  for (const std::string name : {"nsfnet", "germany-17", "jpn-48",
+                                 "nsfnet-full-mesh", "jpn-48-full-mesh"}) {
+    const auto graph =
+        graph::Graph::from(std::format("{}/graph/{}.txt", RESOURCES, name))
+            .value();
+
+    const auto pairs = graph.size() * (graph.size() - 1u);
+
+    const graph::KShortestPath ksp(graph);
+
+    Measure(std::format("route {}-shortest paths {}", Paths, name), pairs,
+            [&]() {
+              uint64_t sum = 0u;
+
+              for (auto source = 0u; source < graph.size(); ++source) {
+                for (auto destination = 0u; destination < graph.size();
+                     ++destination) {
+                  if (source != destination) {
+                    sum += ksp.compute(source, destination, Paths).size();
+                  }
+                }
+              }
+
+              Consume(sum);
+            });
+  }
+}
+}  // namespace benchmark
@@ -0,0 +1,233 @@
+#include <core/continuity.h>
+#include <core/spectrum.h>
+
+#include <algorithm>
+#include <format>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.h"
+
+namespace benchmark {
+constexpr uint64_t Evaluations = 100'000u;
+
+constexpr uint64_t Searches = 1'000'000u;
+
+constexpr uint64_t Links = 44u;
+
+constexpr uint64_t FSUsPerLink = 320u;
+
+// 6.25 GHz slots over the C and L bands.
+constexpr uint64_t FineFSUsPerLink = 1760u;
+
+// Tentative allocation of one slice along a four-hop route, measured the way
+// QLearningAgent does, on an nsfnet-sized network with fragmented links.
+void Spectrum(void) {
+  core::Carriers carriers(Links, core::Spectrum(FSUsPerLink));
+
+  for (auto& spectrum : carriers) {
+    for (auto start = 0u; start + 8u <= FSUsPerLink; start += 8u) {
+      spectrum.allocate({start, start + 3u});
+    }
+  }
+
+  const std::vector<uint64_t> route{3u, 17u, 29u, 40u};
+
+  const core::Slice slice{4u, 7u};
+
+  const core::AbsoluteFragmentation fragmentation;
+
+  Measure("spectrum what-if: copy all carriers", Evaluations, [&]() {
+    auto sum = 0.0;
+
+    for (auto index = 0u; index < Evaluations; ++index) {
+      auto copy = carriers;
+
+      for (const auto link : route) {
+        copy[link].allocate(slice);
+
+        sum += fragmentation(copy[link]);
+      }
+    }
+
+    Consume(sum);
+  });
+
+  Measure("spectrum what-if: copy route links", Evaluations, [&]() {
+    auto sum = 0.0;
+
+    for (auto index = 0u; index < Evaluations; ++index) {
+      for (const auto link : route) {
+        auto copy = carriers[link];
+
+        copy.allocate(slice);
+
+        sum += fragmentation(copy);
+      }
+    }
+
+    Consume(sum);
+  });
+
+  Measure("spectrum what-if: transaction", Evaluations, [&]() {
+    auto sum = 0.0;
+
+    for (auto index = 0u; index < Evaluations; ++index) {
+      for (const auto link : route) {
+        auto& spectrum = carriers[link];
+
+        spectrum.begin_transaction();
+
+        spectrum.allocate(slice);
+
+        sum += fragmentation(spectrum);
+
+        spectrum.rollback();
+      }
+    }
+
+    Consume(sum);
+  });
+
+  // Network-wide fragmentation sample, as the kernel takes one.
+  const core::ExternalFragmentation external;
+
+  const core::EntropyBasedFragmentation entropy(4u);
+
+  Measure("spectrum fragmentation sample", Evaluations, [&]() {
+    auto sum = 0.0;
+
+    for (auto index = 0u; index < Evaluations; ++index) {
+      for (const auto& spectrum : carriers) {
+        sum += fragmentation(spectrum) + external(spectrum) + entropy(spectrum);
+      }
+    }
+
+    Consume(sum);
+  });
+
+  // Fit policies on one fragmented link, asking for a run that only fits at
+  // the far end of the spectrum, on the nsfnet grid and on a fine grid.
+  static const std::vector<std::pair<std::string, core::SpectrumSearch>>
+      searches{
+          {"list", core::SpectrumSearch::List},
+          {"scalar", core::SpectrumSearch::Scalar},
+          {"avx2", core::SpectrumSearch::AVX2},
+          {"avx512", core::SpectrumSearch::AVX512},
+      };
+
+  std::vector<core::Spectrum> links{carriers.front(),
+                                    core::Spectrum(FineFSUsPerLink)};
+
+  for (auto start = 0u; start + 8u <= FineFSUsPerLink; start += 8u) {
+    links.back().allocate({start, start + 3u});
+  }
+
+  for (auto& link : links) {
+    link.deallocate({link.size() - 8u, link.size() - 5u});
+  }
+
+  prng::Engine engine(prng::Engine::Type::Philox, 0u, 0u);
+
+  for (const auto& link : links) {
+    for (const std::string policy :
+         {"first-fit", "best-fit", "worst-fit", "random-fit"}) {
+      for (const auto& [name, search] : searches) {
+        // Random-fit always draws from the list of runs.
+        if (!core::IsSupported(search) ||
+            (policy == "random-fit" && search != core::SpectrumSearch::List)) {
+          continue;
+        }
+
+        const auto allocator =
+            core::SpectrumAllocatorFactory::CreateAllocator(policy, engine,
+                                                            search);
+
+        Measure(std::format("spectrum {} {} {}", policy, name, link.size()),
+                Searches, [&]() {
+                  uint64_t sum = 0u;
+
+                  for (auto index = 0u; index < Searches; ++index) {
+                    sum += allocator(link, 6u)
+                               .value_or(core::Slice(0u, 0u))
+                               .first;
+                  }
+
+                  Consume(sum);
+                });
+      }
+    }
+  }
+
+  // The same policies along routes of one, two and four hops, through the
+  // ContinuityEngine as the kernel calls it, over links filled at random to
+  // about half their capacity so that every hop is fragmented differently.
+  for (const auto FSUs : {FSUsPerLink, FineFSUsPerLink}) {
+    core::Carriers network(Links, core::Spectrum(FSUs));
+
+    for (auto& spectrum : network) {
+      while (spectrum.available() > FSUs / 2u) {
+        const auto start = engine.Below(FSUs);
+
+        const core::Slice slice{start,
+                                std::min(FSUs - 1u, start + engine.Below(12u))};
+
+        if (spectrum.available_at(slice)) {
+          spectrum.allocate(slice);
+        }
+      }
+    }
+
+    for (const auto hops : {1u, 2u, 4u}) {
+      std::vector<std::vector<graph::EdgeId>> routes(64u);
+
+      for (auto& route : routes) {
+        while (route.size() < hops) {
+          const auto link = engine.Below(Links);
+
+          if (std::ranges::find(route, link) == route.end()) {
+            route.push_back(link);
+          }
+        }
+      }
+
+      for (const std::string policy :
+           {"first-fit", "best-fit", "worst-fit", "random-fit"}) {
+        for (const auto& [name, search] : searches) {
+          if (!core::IsSupported(search)) {
+            continue;
+          }
+
+          core::ContinuityEngine continuity(
+              FSUs, search,
+              {core::SpectrumAllocatorFactory::CreateAllocator(policy, engine,
+                                                               search)});
+
+          core::RequestType type{};
+
+          type.FSUs = 6u;
+
+          type.policy = core::SpectrumAllocatorFactory::Policy(policy);
+
+          Measure(std::format("spectrum route {} {} {} {}-hop", policy, name,
+                              FSUs, hops),
+                  Searches / 4u, [&]() {
+                    uint64_t sum = 0u;
+
+                    for (auto index = 0u; index < Searches / 4u; ++index) {
+                      const auto& route = routes[index % routes.size()];
+
+                      sum += continuity.Allocate(network, route, type)
+                                 .value_or(core::Slice(0u, 0u))
+                                 .first;
+                    }
+
+                    Consume(sum);
+                  });
+        }
+      }
+    }
+  }
+}
+}  // namespace benchmark
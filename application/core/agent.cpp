@@ -1,64 +1,37 @@
 #include "agent.h"
 
-#include <graph/router.h>
-#include <hash/cantor.h>
-
-#include <ranges>
-#include <unordered_set>
+#include <format>
+#include <stdexcept>
 
 #include "spectrum.h"
 
 namespace core {
-struct ClassicAgent::Implementation {
-  bool ShouldAccept(Environment& environment) {
-    if (environment.FSUsPerLink <= environment.activeRequests) {
-      return false;
-    }
-
-    const auto keys = GenerateKeys(environment.request.route);
+Trial::Trial(std::span<Spectrum> carriers) : carriers{carriers} {}
 
-    const auto first = *keys.begin();
-
-    const auto slice = environment.request.type.allocator(
-        environment.carriers[first], environment.request.type.FSUs);
-
-    if (!slice.has_value()) {
-      return false;
-    }
-
-    environment.request.slice = slice.value();
-
-    for (const auto& key : keys) {
-      if (environment.carriers.at(key).available() <
-              environment.request.type.FSUs ||
-          !environment.carriers.at(key).available_at(
-              environment.request.slice)) {
-        return false;
-      }
-    }
-
-    return true;
-  }
+void Trial::begin(const graph::EdgeId link) const {
+  carriers[link].begin_transaction();
+}
 
-  uint64_t GenerateKeys(const graph::Vertex source,
-                        const graph::Vertex destination) const {
-    return hash::CantorPairingFunction(source, destination);
+void Trial::allocate(const graph::EdgeId link, const Slice& slice) const {
+  if (!carriers[link].in_transaction()) {
+    throw std::logic_error(
+        std::format("No transaction open on link {}", link));
   }
 
-  std::unordered_set<uint64_t> GenerateKeys(const graph::Route& route) const {
-    const auto& [vertices, cost] = route;
-
-    std::unordered_set<uint64_t> keys;
-
-    for (const auto& index : std::views::iota(1u, vertices.size())) {
-      const auto x = *std::next(vertices.begin(), index - 1);
+  carriers[link].allocate(slice);
+}
 
-      const auto y = *std::next(vertices.begin(), index);
+void Trial::rollback(const graph::EdgeId link) const {
+  carriers[link].rollback();
+}
 
-      keys.insert(hash::CantorPairingFunction(x, y));
+struct ClassicAgent::Implementation {
+  bool ShouldAccept(const Environment& environment) {
+    if (environment.FSUsPerLink <= environment.activeRequests) {
+      return false;
     }
 
-    return keys;
+    return environment.slice.has_value();
   }
 };
 
@@ -66,7 +39,7 @@ ClassicAgent::ClassicAgent() { pImpl = std::make_unique<Implementation>(); }
 
 ClassicAgent::~ClassicAgent() {}
 
-bool ClassicAgent::ShouldAccept(Environment& environment) {
+bool ClassicAgent::ShouldAccept(const Environment& environment) {
   return pImpl->ShouldAccept(environment);
 }
 
@@ -78,71 +51,36 @@ struct QLearningAgent::Implementation {
   std::vector<std::vector<int>> qRewards;
   std::vector<std::vector<double>> qStates;
 
-  bool ShouldAccept(Environment& environment) {
+  bool ShouldAccept(const Environment& environment) {
     if (environment.FSUsPerLink <= environment.activeRequests) {
       return false;
     }
 
-    const auto keys = GenerateKeys(environment.request.route);
-
-    const auto first = *keys.begin();
-
-    const auto slice = environment.request.type.allocator(
-        environment.carriers[first], environment.request.type.FSUs);
+    const auto& slice = environment.slice;
 
     if (!slice.has_value()) {
       return false;
     }
 
-    for (const auto& key : keys) {
-      if (environment.carriers.at(key).available() <
-              environment.request.type.FSUs ||
-          !environment.carriers.at(key).available_at(
-              environment.request.slice)) {
-        return false;
-      }
-    }
-
-    auto carriers = environment.carriers;
-
-    const auto allocate = [&](const auto key) {
-      carriers[key].allocate(environment.request.slice);
-    };
-
-    std::for_each(keys.begin(), keys.end(), allocate);
+    const auto links = environment.path.links;
 
     AbsoluteFragmentation fragmentation;
 
     double meanFragmentation = 0.0;
 
-    for (const auto& key : keys) {
-      meanFragmentation += fragmentation(carriers.at(key));
-    }
-
-    meanFragmentation /= keys.size();
-
-    return meanFragmentation < 0.75;
-  }
-
-  uint64_t GenerateKeys(const graph::Vertex source,
-                        const graph::Vertex destination) const {
-    return hash::CantorPairingFunction(source, destination);
-  }
-
-  std::unordered_set<uint64_t> GenerateKeys(const graph::Route& route) const {
-    const auto& [vertices, cost] = route;
-
-    std::unordered_set<uint64_t> keys;
+    for (const auto link : links) {
+      environment.trial.begin(link);
 
-    for (const auto& index : std::views::iota(1u, vertices.size())) {
-      const auto x = *std::next(vertices.begin(), index - 1);
+      environment.trial.allocate(link, slice.value());
 
-      const auto y = *std::next(vertices.begin(), index);
+      meanFragmentation += fragmentation(environment.carriers[link]);
 
-      keys.insert(hash::CantorPairingFunction(x, y));
+      environment.trial.rollback(link);
     }
 
-    return keys;
+    meanFragmentation /= links.size();
+
+    return meanFragmentation < 0.75;
   }
 };
 
@@ -150,7 +88,7 @@ QLearningAgent::QLearningAgent() { pImpl = std::make_unique<Implementation>(); }
 
 QLearningAgent::~QLearningAgent() {}
 
-bool QLearningAgent::ShouldAccept(Environment& environment) {
+bool QLearningAgent::ShouldAccept(const Environment& environment) {
   return pImpl->ShouldAccept(environment);
 }
 
@@ -1,46 +1,79 @@
 #pragma once
 
+#include <graph/edge.h>
+
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
 
 #include "request.h"
 #include "spectrum.h"
 
 namespace core {
+// The only write access agents get to the links: tentative allocations, each
+// journaled in a transaction on its link and visible through the carriers
+// until it is rolled back.
+class Trial final {
+ public:
+  Trial(std::span<Spectrum>);
+
+  void begin(const graph::EdgeId) const;
+
+  // The link must have a transaction open.
+  void allocate(const graph::EdgeId, const Slice&) const;
+
+  void rollback(const graph::EdgeId) const;
+
+ private:
+  std::span<Spectrum> carriers;
+};
+
+// View of the network at decision time. It borrows the kernel's state rather
+// than copying it, so evaluating a request costs in proportion to its route,
+// and it must not outlive the ShouldAccept call it is passed to. The links are
+// read-only; agents may try placements through trial but must roll them back,
+// so the links are unchanged when ShouldAccept returns.
 struct Environment final {
-  Request request;
-  Carriers carriers;
+  const Request& request;
+  // The request's path, resolved from its ID.
+  graph::Path path;
+  std::span<const Spectrum> carriers;
+  Trial trial;
+  // Slice the route's fit policy found free on every hop, if any; it is what
+  // the kernel allocates when the request is accepted.
+  std::optional<Slice> slice;
   uint64_t activeRequests;
   uint64_t FSUsPerLink;
 };
 
 class Agent {
  public:
-  ~Agent(void) = default;
+  virtual ~Agent(void) = default;
 
-  [[nodiscard]] virtual bool ShouldAccept(Environment&) = 0;
+  [[nodiscard]] virtual bool ShouldAccept(const Environment&) = 0;
 };
 
-class ClassicAgent : public Agent {
+class ClassicAgent final : public Agent {
  public:
   ClassicAgent();
 
   ~ClassicAgent();
 
-  [[nodiscard]] bool ShouldAccept(Environment&) override;
+  [[nodiscard]] bool ShouldAccept(const Environment&) override;
 
  private:
   struct Implementation;
   std::unique_ptr<Implementation> pImpl;
 };
 
-class QLearningAgent : public Agent {
+class QLearningAgent final : public Agent {
  public:
   QLearningAgent();
 
   ~QLearningAgent();
 
-  [[nodiscard]] bool ShouldAccept(Environment&) override;
+  [[nodiscard]] bool ShouldAccept(const Environment&) override;
 
  private:
   struct Implementation;
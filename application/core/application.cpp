@@ -1,15 +1,22 @@
 #include "application.h"
 
+#include <prng/prng.h>
+
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <ctime>
+#include <exception>
 #include <format>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <optional>
 #include <ranges>
 #include <stacktrace>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "configuration.h"
 #include "document.h"
@@ -46,34 +53,49 @@ int Application::Run(const int argc, const char** argv) {
       return 1;
     }
 
-    core::Kernel kernel(configuration);
+    // Replications are independent, so workers simply claim the next
+    // iteration number until none is left. Each one derives its seed from the
+    // iteration alone, which keeps the output identical for any worker count.
+    std::atomic<uint64_t> next{1u};
 
-    for (const auto iteration :
-         std::ranges::views::iota(1u, configuration->iterations + 1u)) {
-      std::clog << "Running iteration #" << iteration << std::endl;
+    std::mutex mutex;
 
-      const auto execution_time = Benchmark([&]() { kernel.Run(); });
+    std::exception_ptr failure;
 
-      std::clog << "Ended iteration #" << iteration << std::endl;
+    const auto worker = [&]() {
+      for (auto iteration = next++; iteration <= configuration->iterations;
+           iteration = next++) {
+        try {
+          Replicate(configuration, dirname, iteration);
+        } catch (...) {
+          const std::lock_guard<std::mutex> lock(mutex);
 
-      const std::string report_filename =
-          dirname + std::format("/{:02}_report.txt", iteration);
+          if (!failure) {
+            failure = std::current_exception();
+          }
 
-      core::Document document = kernel.GetReport();
+          next = configuration->iterations + 1u;
 
-      document.append("iteration: {}\n", iteration)
-          .append("execution time (s): {}\n", execution_time);
+          return;
+        }
+      }
+    };
 
-      document.write(report_filename);
+    const auto workers =
+        std::min(configuration->workers, configuration->iterations);
 
-      if (configuration->exportDataset) {
-        const std::string filename =
-            dirname + std::format("/{:02}_dataset.csv", iteration);
+    {
+      std::vector<std::jthread> threads;
 
-        kernel.ExportDataset(filename);
+      for (auto index = 1u; index < workers; ++index) {
+        threads.emplace_back(worker);
       }
 
-      kernel.Reset();
+      worker();
+    }
+
+    if (failure) {
+      std::rethrow_exception(failure);
     }
 
     return 0;
@@ -84,6 +106,43 @@ int Application::Run(const int argc, const char** argv) {
   }
 }
 
+void Application::Replicate(std::shared_ptr<Configuration> configuration,
+                            const std::string& dirname,
+                            const uint64_t iteration) {
+  // Kernels keep their random state to themselves, so every replication
+  // shares the one configuration.
+  core::Kernel kernel(configuration,
+                      prng::SplitMix64(configuration->seed + iteration));
+
+  std::clog << std::format("Running iteration #{}\n", iteration);
+
+  const auto execution_time = Benchmark([&]() { kernel.Run(); });
+
+  std::clog << std::format("Ended iteration #{}\n", iteration);
+
+  const std::string report_filename =
+      dirname + std::format("/{:02}_report.txt", iteration);
+
+  core::Document document = kernel.GetReport();
+
+  document.append("iteration: {}\n", iteration)
+      .append("master seed: {}\n", configuration->seed)
+      .append("execution time (s): {}\n", execution_time)
+      .append("routes per pair: {}\n", configuration->paths)
+      .append("route precompute time (s): {:.6f}\n", configuration->routingTime)
+      .append("route table memory (KiB): {:.1f}\n",
+              static_cast<double>(configuration->routes->memory()) / 1024.0);
+
+  document.write(report_filename);
+
+  if (configuration->exportDataset) {
+    const std::string filename =
+        dirname + std::format("/{:02}_dataset.csv", iteration);
+
+    kernel.ExportDataset(filename);
+  }
+}
+
 double Application::Benchmark(std::function<void()> callable) {
   const std::chrono::time_point<std::chrono::system_clock> start =
       std::chrono::system_clock::now();
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <string>
 
+#include "configuration.h"
+
 namespace core {
 class Application final {
  public:
@@ -11,6 +14,9 @@ class Application final {
  private:
   [[nodiscard]] double Benchmark(std::function<void()>);
 
+  void Replicate(std::shared_ptr<Configuration>, const std::string&,
+                 const uint64_t);
+
   [[nodiscard]] std::string GetConfigFilenameFromArgs(const int, const char**);
 };
 }  // namespace core
@@ -0,0 +1,309 @@
+#include "bitmap.h"
+
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace core {
+// mask &= mask >> shift, reading the words as one little-endian integer whose
+// bits past the end are zero. Word w only depends on words w and above, so it
+// is safe to update in place from the bottom up.
+static void AndShiftedScalar(std::span<uint64_t> mask, const uint64_t shift,
+                             uint64_t word = 0u) {
+  const auto words = shift / 64u;
+
+  const auto bits = shift % 64u;
+
+  for (; word < mask.size(); ++word) {
+    const auto low = word + words < mask.size() ? mask[word + words] : 0u;
+
+    const auto high =
+        word + words + 1u < mask.size() ? mask[word + words + 1u] : 0u;
+
+    mask[word] &= bits ? (low >> bits) | (high << (64u - bits)) : low;
+  }
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) static void AndShiftedAVX2(
+    std::span<uint64_t> mask, const uint64_t shift) {
+  const auto words = shift / 64u;
+
+  const auto right = _mm_cvtsi64_si128(static_cast<int64_t>(shift % 64u));
+
+  // A left shift by 64 yields zero, which is what bits == 0 needs.
+  const auto left = _mm_cvtsi64_si128(static_cast<int64_t>(64u - shift % 64u));
+
+  auto word = 0u;
+
+  for (; word + words + 4u < mask.size(); word += 4u) {
+    const auto low = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(&mask[word + words]));
+
+    const auto high = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(&mask[word + words + 1u]));
+
+    const auto shifted = _mm256_or_si256(_mm256_srl_epi64(low, right),
+                                         _mm256_sll_epi64(high, left));
+
+    const auto current =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&mask[word]));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&mask[word]),
+                        _mm256_and_si256(current, shifted));
+  }
+
+  AndShiftedScalar(mask, shift, word);
+}
+
+__attribute__((target("avx512f"))) static void AndShiftedAVX512(
+    std::span<uint64_t> mask, const uint64_t shift) {
+  const auto words = shift / 64u;
+
+  const auto right = _mm_cvtsi64_si128(static_cast<int64_t>(shift % 64u));
+
+  const auto left = _mm_cvtsi64_si128(static_cast<int64_t>(64u - shift % 64u));
+
+  auto word = 0u;
+
+  for (; word + words + 8u < mask.size(); word += 8u) {
+    const auto low = _mm512_loadu_si512(&mask[word + words]);
+
+    const auto high = _mm512_loadu_si512(&mask[word + words + 1u]);
+
+    // The zero-masked forms avoid GCC's uninitialized pass-through operand.
+    const auto shifted =
+        _mm512_or_si512(_mm512_maskz_srl_epi64(0xFF, low, right),
+                        _mm512_maskz_sll_epi64(0xFF, high, left));
+
+    const auto current = _mm512_loadu_si512(&mask[word]);
+
+    _mm512_storeu_si512(&mask[word], _mm512_and_si512(current, shifted));
+  }
+
+  AndShiftedScalar(mask, shift, word);
+}
+#endif
+
+static void CombineScalar(std::span<uint64_t> into,
+                          std::span<const uint64_t> from, uint64_t word = 0u) {
+  for (; word < into.size(); ++word) {
+    into[word] |= from[word];
+  }
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) static void CombineAVX2(
+    std::span<uint64_t> into, std::span<const uint64_t> from) {
+  auto word = 0u;
+
+  for (; word + 4u <= into.size(); word += 4u) {
+    const auto a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&into[word]));
+
+    const auto b =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&from[word]));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&into[word]),
+                        _mm256_or_si256(a, b));
+  }
+
+  CombineScalar(into, from, word);
+}
+
+__attribute__((target("avx512f"))) static void CombineAVX512(
+    std::span<uint64_t> into, std::span<const uint64_t> from) {
+  auto word = 0u;
+
+  for (; word + 8u <= into.size(); word += 8u) {
+    const auto a = _mm512_loadu_si512(&into[word]);
+
+    const auto b = _mm512_loadu_si512(&from[word]);
+
+    _mm512_storeu_si512(&into[word], _mm512_or_si512(a, b));
+  }
+
+  CombineScalar(into, from, word);
+}
+#endif
+
+static void AndShifted(std::span<uint64_t> mask, const uint64_t shift,
+                       const SpectrumSearch search) {
+#if defined(__x86_64__)
+  if (search == SpectrumSearch::AVX512) {
+    return AndShiftedAVX512(mask, shift);
+  }
+
+  if (search == SpectrumSearch::AVX2) {
+    return AndShiftedAVX2(mask, shift);
+  }
+#endif
+
+  AndShiftedScalar(mask, shift);
+}
+
+// Length of the free run starting at FSU start.
+static uint64_t RunLength(std::span<const uint64_t> bitmap,
+                          const uint64_t start) {
+  auto word = start / 64u;
+
+  auto offset = start % 64u;
+
+  uint64_t length = 0u;
+
+  while (word < bitmap.size()) {
+    const auto bits = 64u - offset;
+
+    const auto free = std::min<uint64_t>(
+        std::countr_zero(bitmap[word] >> offset), bits);
+
+    length += free;
+
+    if (free < bits) {
+      break;
+    }
+
+    ++word;
+
+    offset = 0u;
+  }
+
+  return length;
+}
+
+void Combine(std::span<uint64_t> into, std::span<const uint64_t> from,
+             const SpectrumSearch search) {
+#if defined(__x86_64__)
+  if (search == SpectrumSearch::AVX512) {
+    return CombineAVX512(into, from);
+  }
+
+  if (search == SpectrumSearch::AVX2) {
+    return CombineAVX2(into, from);
+  }
+#endif
+
+  CombineScalar(into, from);
+}
+
+bool IsSupported(const SpectrumSearch search) noexcept {
+#if defined(__x86_64__)
+  if (search == SpectrumSearch::AVX2) {
+    return __builtin_cpu_supports("avx2");
+  }
+
+  if (search == SpectrumSearch::AVX512) {
+    return __builtin_cpu_supports("avx512f");
+  }
+#else
+  if (search == SpectrumSearch::AVX2 || search == SpectrumSearch::AVX512) {
+    return false;
+  }
+#endif
+
+  return true;
+}
+
+SpectrumSearch FastestSpectrumSearch(void) noexcept {
+  for (const auto search : {SpectrumSearch::AVX512, SpectrumSearch::AVX2}) {
+    if (IsSupported(search)) {
+      return search;
+    }
+  }
+
+  return SpectrumSearch::Scalar;
+}
+
+std::optional<uint64_t> FindFreeRun(std::span<const uint64_t> bitmap,
+                                    const uint64_t FSUs, const FitPolicy policy,
+                                    const SpectrumSearch search) {
+  if (search == SpectrumSearch::List) {
+    throw std::invalid_argument("FindFreeRun needs a bitmap kernel");
+  }
+
+  if (FSUs == 0u || bitmap.empty()) {
+    return std::nullopt;
+  }
+
+  thread_local std::vector<uint64_t> scratch;
+
+  scratch.resize(bitmap.size());
+
+  const std::span<uint64_t> mask(scratch);
+
+  for (auto word = 0u; word < bitmap.size(); ++word) {
+    mask[word] = ~bitmap[word];
+  }
+
+  // Shift-and doubling: afterwards bit i is set iff FSUs i to i + FSUs - 1
+  // are all free. The final step may overlap the covered prefix, which is
+  // harmless.
+  auto covered = 1u;
+
+  for (; 2u * covered <= FSUs; covered *= 2u) {
+    AndShifted(mask, covered, search);
+  }
+
+  if (covered < FSUs) {
+    AndShifted(mask, FSUs - covered, search);
+  }
+
+  // Keep only the starts of free runs, so each run is reported once.
+  const auto candidates = [&](const uint64_t word) {
+    const auto free = ~bitmap[word];
+
+    const auto carry = word ? ~bitmap[word - 1u] >> 63u : 0u;
+
+    return mask[word] & free & ~(free << 1u | carry);
+  };
+
+  if (policy == FitPolicy::First) {
+    for (auto word = 0u; word < bitmap.size(); ++word) {
+      if (const auto bits = candidates(word)) {
+        return word * 64u + std::countr_zero(bits);
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  if (policy == FitPolicy::Last) {
+    for (auto word = bitmap.size(); word > 0u; --word) {
+      if (const auto bits = candidates(word - 1u)) {
+        return (word - 1u) * 64u + 63u - std::countl_zero(bits);
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  std::optional<uint64_t> chosen;
+
+  uint64_t chosenLength = 0u;
+
+  for (auto word = 0u; word < bitmap.size(); ++word) {
+    for (auto bits = candidates(word); bits; bits &= bits - 1u) {
+      const auto start = word * 64u + std::countr_zero(bits);
+
+      const auto length = RunLength(bitmap, start);
+
+      const auto better = policy == FitPolicy::Best ? length < chosenLength
+                                                    : length > chosenLength;
+
+      if (!chosen.has_value() || better) {
+        chosen = start;
+
+        chosenLength = length;
+      }
+    }
+  }
+
+  return chosen;
+}
+}  // namespace core
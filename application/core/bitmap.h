@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace core {
+// How the fit policies look for free FSUs: by querying Spectrum's index of
+// free runs, or by searching its packed occupancy bitmap with one of the
+// bitmap kernels below. Routes of several hops have no index of their own, so
+// under List their merged bitmap is searched with the fastest kernel.
+enum class SpectrumSearch {
+  List,
+  Scalar,
+  AVX2,
+  AVX512,
+};
+
+enum class FitPolicy {
+  Best,
+  First,
+  Last,
+  Worst,
+};
+
+[[nodiscard]] bool IsSupported(const SpectrumSearch) noexcept;
+
+// Widest bitmap kernel the running CPU supports.
+[[nodiscard]] SpectrumSearch FastestSpectrumSearch(void) noexcept;
+
+// into |= from, word by word: the union of allocations over several links.
+void Combine(std::span<uint64_t>, std::span<const uint64_t>,
+             const SpectrumSearch);
+
+// Searches a bitmap where bit i % 64 of word i / 64 is set when FSU i is
+// allocated, with the bits past the last FSU set as well. Returns the start of
+// the free run the policy picks among those at least FSUs long, with the same
+// tie-breaking as the list-based policies: the lowest such run, except for
+// last-fit which takes the highest. The search is allocation-free once the
+// calling thread has seen a bitmap of the same size.
+[[nodiscard]] std::optional<uint64_t> FindFreeRun(std::span<const uint64_t>,
+                                                  const uint64_t,
+                                                  const FitPolicy,
+                                                  const SpectrumSearch);
+}  // namespace core
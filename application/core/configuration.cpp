@@ -1,15 +1,15 @@
 #include "configuration.h"
 
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
 namespace core {
 std::optional<std::shared_ptr<Configuration>> Configuration::From(
     const Json& json) {
-  static const std::unordered_map<std::string, SpectrumAllocator>
-      spectrumAllocationStrategies{{"best-fit", BestFit},
-                                   {"first-fit", FirstFit},
-                                   {"last-fit", LastFit},
-                                   {"random-fit", RandomFit},
-                                   {"worst-fit", WorstFit}};
-
   static const std::unordered_map<std::string,
                                   ModulationStrategyFactory::Option>
       modulationOptions{
@@ -18,6 +18,21 @@ std::optional<std::shared_ptr<Configuration>> Configuration::From(
           {"terabits", ModulationStrategyFactory::Option::Terabits},
       };
 
+  static const std::unordered_map<std::string, prng::Engine::Type>
+      generatorOptions{
+          {"mt19937", prng::Engine::Type::MersenneTwister},
+          {"philox", prng::Engine::Type::Philox},
+          {"xoshiro", prng::Engine::Type::Xoshiro},
+      };
+
+  static const std::unordered_map<std::string, SpectrumSearch>
+      spectrumSearchOptions{
+          {"list", SpectrumSearch::List},
+          {"scalar", SpectrumSearch::Scalar},
+          {"avx2", SpectrumSearch::AVX2},
+          {"avx512", SpectrumSearch::AVX512},
+      };
+
   auto configuration = std::make_shared<Configuration>();
 
   configuration->enableLogging = json.Get<bool>("enable-logging").value();
@@ -29,6 +44,9 @@ std::optional<std::shared_ptr<Configuration>> Configuration::From(
 
   configuration->agent = json.Get<std::string>("params.agent").value();
 
+  configuration->scheduler =
+      json.Get<std::string>("params.scheduler").value_or("calendar");
+
   configuration->ignoreFirst = json.Get<bool>("params.ignore-first").value();
 
   configuration->samplingTime =
@@ -43,6 +61,36 @@ std::optional<std::shared_ptr<Configuration>> Configuration::From(
 
   configuration->iterations = json.Get<uint64_t>("params.iterations").value();
 
+  configuration->workers = std::max<uint64_t>(
+      1u, json.Get<uint64_t>("params.workers")
+              .value_or(std::thread::hardware_concurrency()));
+
+  configuration->paths =
+      std::max<uint64_t>(1u, json.Get<uint64_t>("params.paths").value_or(1u));
+
+  configuration->seed =
+      json.Get<uint64_t>("params.seed").value_or(std::random_device{}());
+
+  configuration->generator = generatorOptions.at(
+      json.Get<std::string>("params.generator").value_or("philox"));
+
+  const auto spectrumSearch =
+      json.Get<std::string>("params.spectrum-search");
+
+  // Per link, the run index answers a fit query in O(log n), well ahead of
+  // any bitmap kernel; on longer routes List searches the merged bitmap with
+  // the fastest kernel anyway.
+  configuration->spectrumSearch =
+      spectrumSearch.has_value()
+          ? spectrumSearchOptions.at(spectrumSearch.value())
+          : SpectrumSearch::List;
+
+  if (!IsSupported(configuration->spectrumSearch)) {
+    throw std::invalid_argument(std::format(
+        "Spectrum search '{}' is not supported by this CPU",
+        spectrumSearch.value()));
+  }
+
   configuration->spectrumWidth =
       json.Get<double>("params.spectrum-width").value();
 
@@ -66,15 +114,29 @@ std::optional<std::shared_ptr<Configuration>> Configuration::From(
 
     requestType.bandwidth = row["bandwidth"];
 
-    requestType.allocator = spectrumAllocationStrategies.at(row["allocator"]);
+    requestType.allocation = row["allocator"];
+
+    if (!SpectrumAllocatorFactory::Contains(requestType.allocation)) {
+      throw std::invalid_argument(
+          std::format("Unknown allocator '{}'", requestType.allocation));
+    }
 
-    requestType.blocking = 0u;
+    requestType.policy =
+        SpectrumAllocatorFactory::Policy(requestType.allocation);
+
+    if (std::ranges::any_of(configuration->requestTypes,
+                            [&](const RequestType& other) {
+                              return other.type == requestType.type;
+                            })) {
+      throw std::invalid_argument(
+          std::format("Duplicate request type '{}'", requestType.type));
+    }
 
     requestType.FSUs = 0u;
 
-    requestType.counting = 0u;
+    requestType.id = static_cast<uint32_t>(configuration->requestTypes.size());
 
-    configuration->requestTypes[requestType.type] = requestType;
+    configuration->requestTypes.push_back(requestType);
   }
 
   const auto modulations = json.Get<std::vector<nlohmann::json>>("modulation");
@@ -87,28 +149,23 @@ std::optional<std::shared_ptr<Configuration>> Configuration::From(
     const ModulationStrategyFactory factory;
 
     const auto spectralEfficiency =
-        configuration->modulations.at(request.second.modulation);
+        configuration->modulations.at(request.modulation);
 
     const auto strategy =
         factory.From(configuration->modulationOption, configuration->slotWidth,
                      spectralEfficiency);
 
-    request.second.FSUs = configuration->modulationOption ==
-                                  ModulationStrategyFactory::Option::Passband
-                              ? strategy->compute(request.second.bandwidth)
-                              : strategy->compute(graph::Cost::max().value);
-
-    request.second.counting = 0u;
-
-    request.second.blocking = 0u;
+    request.FSUs = configuration->modulationOption ==
+                           ModulationStrategyFactory::Option::Passband
+                       ? strategy->compute(request.bandwidth)
+                       : strategy->compute(graph::Cost::max().value);
   }
 
-  configuration->minFSUsPerRequest =
-      (*configuration->requestTypes.begin()).second.FSUs;
+  configuration->minFSUsPerRequest = configuration->requestTypes.front().FSUs;
 
   for (const auto& request : configuration->requestTypes) {
-    if (request.second.FSUs < configuration->minFSUsPerRequest) {
-      configuration->minFSUsPerRequest = request.second.FSUs;
+    if (request.FSUs < configuration->minFSUsPerRequest) {
+      configuration->minFSUsPerRequest = request.FSUs;
     }
   }
 
@@ -135,6 +192,39 @@ std::optional<std::shared_ptr<Configuration>> Configuration::From(
 
   configuration->graph = std::move(graph.value());
 
+  // All-pairs routing, spread over the worker threads before any replication
+  // starts.
+  const auto start = std::chrono::steady_clock::now();
+
+  configuration->routes = std::make_shared<const graph::RouteTable>(
+      configuration->graph, configuration->paths, configuration->workers);
+
+  configuration->routingTime = std::chrono::duration<double>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count();
+
+  const auto traffic = json.Get<std::string>("params.traffic");
+
+  if (!traffic.has_value()) {
+    configuration->traffic = TrafficMatrix(configuration->graph.size());
+
+    return configuration;
+  }
+
+  const auto matrix = TrafficMatrix::from(traffic.value());
+
+  if (!matrix.has_value()) {
+    return std::nullopt;
+  }
+
+  if (matrix->size() != configuration->graph.size()) {
+    throw std::invalid_argument(
+        std::format("Traffic matrix has {} vertices, topology has {}",
+                    matrix->size(), configuration->graph.size()));
+  }
+
+  configuration->traffic = matrix.value();
+
   return configuration;
 }
 }  // namespace core
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <graph/graph.h>
+#include <graph/table.h>
+#include <prng/engine.h>
 
 #include <functional>
 #include <memory>
@@ -13,17 +15,25 @@
 #include "logger.h"
 #include "request.h"
 #include "spectrum.h"
+#include "traffic.h"
 
 namespace core {
 struct Configuration final {
   graph::Graph graph;
+  // Built once at load time and shared by every replication.
+  std::shared_ptr<const graph::RouteTable> routes;
+  TrafficMatrix traffic;
   ModulationStrategyFactory::Option modulationOption;
+  prng::Engine::Type generator;
+  SpectrumSearch spectrumSearch;
   std::unordered_map<std::string, FragmentationStrategy>
       fragmentationStrategies;
-  std::unordered_map<std::string, RequestType> requestTypes;
+  // Indexed by RequestType::id; probs[id] is the class's share of arrivals.
+  std::vector<RequestType> requestTypes;
   std::unordered_map<std::string, uint64_t> modulations;
   std::vector<double> probs;
   std::string agent;
+  std::string scheduler;
   double arrivalRate;
   double serviceRate;
   double timeUnits;
@@ -32,7 +42,13 @@ struct Configuration final {
   uint64_t FSUsPerLink;
   uint64_t minFSUsPerRequest;
   uint64_t iterations;
+  uint64_t workers;
+  // Routes kept per pair, tried cheapest first.
+  uint64_t paths;
+  uint64_t seed;
   uint64_t samplingTime;
+  // Wall-clock seconds spent building the route table.
+  double routingTime;
   bool ignoreFirst;
   bool exportDataset;
   bool enableLogging;
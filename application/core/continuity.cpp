@@ -0,0 +1,101 @@
+#include "continuity.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace core {
+ContinuityEngine::ContinuityEngine(const uint64_t FSUsPerLink,
+                                   const SpectrumSearch search,
+                                   std::vector<SpectrumAllocator> allocators)
+    : search{search},
+      kernel{search == SpectrumSearch::List ? FastestSpectrumSearch()
+                                            : search},
+      allocators{std::move(allocators)},
+      scratch(FSUsPerLink) {
+  merged.resize(scratch.bitmap().size());
+}
+
+// The list-based function behind a deterministic policy.
+static std::optional<Slice> Query(const Spectrum& spectrum,
+                                  const uint64_t FSUs,
+                                  const FitPolicy policy) {
+  if (policy == FitPolicy::Best) {
+    return BestFit(spectrum, FSUs);
+  }
+
+  if (policy == FitPolicy::First) {
+    return FirstFit(spectrum, FSUs);
+  }
+
+  if (policy == FitPolicy::Last) {
+    return LastFit(spectrum, FSUs);
+  }
+
+  return WorstFit(spectrum, FSUs);
+}
+
+void ContinuityEngine::Merge(std::span<const Spectrum> carriers,
+                             std::span<const graph::EdgeId> links) {
+  const auto first = carriers[links.front()].bitmap();
+
+  std::copy(first.begin(), first.end(), merged.begin());
+
+  for (const auto link : links.subspan(1u)) {
+    Combine(merged, carriers[link].bitmap(), kernel);
+  }
+}
+
+std::optional<Slice> ContinuityEngine::Allocate(
+    std::span<const Spectrum> carriers, std::span<const graph::EdgeId> links,
+    const RequestType& type) {
+  if (type.policy.has_value()) {
+    return Fit(carriers, links, type.FSUs, type.policy.value());
+  }
+
+  if (links.empty()) {
+    return std::nullopt;
+  }
+
+  const auto& allocator = allocators.at(type.id);
+
+  if (links.size() == 1u) {
+    return allocator(carriers[links.front()], type.FSUs);
+  }
+
+  Merge(carriers, links);
+
+  scratch.assign(merged);
+
+  return allocator(scratch, type.FSUs);
+}
+
+std::optional<Slice> ContinuityEngine::Fit(std::span<const Spectrum> carriers,
+                                           std::span<const graph::EdgeId> links,
+                                           const uint64_t FSUs,
+                                           const FitPolicy policy) {
+  if (links.empty()) {
+    return std::nullopt;
+  }
+
+  const auto& first = carriers[links.front()];
+
+  if (links.size() == 1u && search == SpectrumSearch::List) {
+    return Query(first, FSUs, policy);
+  }
+
+  if (links.size() > 1u) {
+    Merge(carriers, links);
+  }
+
+  const auto start =
+      FindFreeRun(links.size() > 1u ? std::span<const uint64_t>(merged)
+                                    : first.bitmap(),
+                  FSUs, policy, kernel);
+
+  if (!start.has_value()) {
+    return std::nullopt;
+  }
+
+  return Slice(start.value(), start.value() + FSUs - 1u);
+}
+}  // namespace core
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <graph/edge.h>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "bitmap.h"
+#include "request.h"
+#include "spectrum.h"
+
+namespace core {
+// Route-level allocation. A slice must be free and contiguous on every hop,
+// so the engine merges the links' allocation bitmaps in one pass and runs the
+// request's fit policy once on the result, instead of choosing on the first
+// link and probing the others. Deterministic policies search the merged
+// bitmap directly, with the fastest bitmap kernel when List search is chosen,
+// since building a run index per route would cost more than the search it
+// speeds up. Randomized policies see the merged bitmap as a scratch Spectrum,
+// through the allocator bound for the request type: the engine owns one per
+// RequestType::id, built against its owner's generator, so the shared
+// configuration never holds per-kernel state. A route of one link needs no
+// merge: it is searched in place, through the link's own run index or bitmap
+// as chosen.
+class ContinuityEngine final {
+ public:
+  ContinuityEngine(const uint64_t, const SpectrumSearch,
+                   std::vector<SpectrumAllocator> = {});
+
+  [[nodiscard]] std::optional<Slice> Allocate(std::span<const Spectrum>,
+                                              std::span<const graph::EdgeId>,
+                                              const RequestType&);
+
+ private:
+  SpectrumSearch search;
+  // Bitmap kernel for merging and for searching bitmaps.
+  SpectrumSearch kernel;
+  std::vector<SpectrumAllocator> allocators;
+  std::vector<uint64_t> merged;
+  Spectrum scratch;
+
+  void Merge(std::span<const Spectrum>, std::span<const graph::EdgeId>);
+
+  // A deterministic policy, without going through the type's allocator.
+  [[nodiscard]] std::optional<Slice> Fit(std::span<const Spectrum>,
+                                         std::span<const graph::EdgeId>,
+                                         const uint64_t, const FitPolicy);
+};
+}  // namespace core
@@ -1,27 +1,24 @@
 #include "kernel.h"
 
-#include <hash/cantor.h>
+#include <prng/prng.h>
 
+#include <algorithm>
+#include <ctime>
 #include <format>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "agent.h"
+#include "continuity.h"
+#include "pool.h"
 
 namespace core {
-Event::Event(const double time, const Event::Type& type, const Request& request)
-    : time{time}, type{type}, request{request} {}
-
-bool Event::operator<(const Event& other) const noexcept {
-  return time > other.time;
-}
-
-Event Event::MakeArrival(const double time, const Request& request) {
-  return Event(time, Event::Type::Arrival, request);
-}
-
-Event Event::MakeDeparture(const double time, const Request& request) {
-  return Event(time, Event::Type::Departure, request);
-}
-
 void Statistics::Reset(void) {
   absolute_fragmentation = 0;
 
@@ -60,165 +57,346 @@ std::string Statistics::Serialize(void) const {
 }
 
 struct Kernel::Implementation {
-  graph::Router router;
+  std::vector<double> demand;
   Carriers carriers;
-  std::priority_queue<Event> queue;
+  std::unique_ptr<Scheduler> scheduler;
+  Pool<Request> requests;
   std::vector<Statistics> snapshots;
   Statistics statistics;
-  std::vector<std::string> requestsKeys;
+  std::vector<uint64_t> counting;
+  std::vector<uint64_t> blocking;
   double k_to_ignore;
+  uint64_t seed;
   bool ignored_first_k;
   std::shared_ptr<Configuration> configuration;
   std::shared_ptr<prng::PseudoRandomNumberGenerator> prng;
+  prng::Variable<prng::ExponentialBlock> arrival;
+  prng::Variable<prng::ExponentialBlock> service;
+  prng::Variable<prng::Alias> fsus;
+  prng::Variable<prng::Alias> pairs;
   std::unique_ptr<Agent> agent;
+  std::unique_ptr<ContinuityEngine> continuity;
+  // Looked up once: finding them by name builds a key string every sample.
+  FragmentationStrategy absoluteFragmentation;
+  FragmentationStrategy entropyFragmentation;
+  FragmentationStrategy externalFragmentation;
+
+  // Per-link fragmentation as of the last sample, and its totals. Links
+  // touched since then are stamped with the current epoch and queued once in
+  // dirty, so a sample re-evaluates only those and patches their terms in the
+  // totals: its cost follows the links touched, not the network size.
+  std::vector<double> absolute;
+  std::vector<double> entropy;
+  std::vector<double> external;
+  LinkSum absoluteTotal;
+  LinkSum entropyTotal;
+  LinkSum externalTotal;
+  std::vector<graph::EdgeId> dirty;
+  std::vector<uint64_t> stamps;
+  uint64_t epoch;
+
+  Implementation(std::shared_ptr<Configuration> configuration,
+                 const uint64_t seed)
+      : k_to_ignore{0.1 * configuration->timeUnits},
+        seed{seed},
+        configuration{configuration},
+        prng{std::make_shared<prng::PseudoRandomNumberGenerator>(
+            configuration->generator)} {
+    scheduler = SchedulerFactory::CreateScheduler(configuration->scheduler);
+
+    if (!scheduler) {
+      throw std::invalid_argument(
+          std::format("Unknown scheduler '{}'", configuration->scheduler));
+    }
+
+    // Pairs the topology cannot connect are never drawn.
+    const auto weights = configuration->traffic.weights();
+
+    demand.assign(weights.begin(), weights.end());
+
+    for (auto index = 0u; index < demand.size(); ++index) {
+      if (configuration->routes->count(index) == 0u) {
+        demand[index] = 0.0;
+      }
+    }
+
+    if (std::none_of(demand.begin(), demand.end(),
+                     [](const double weight) { return weight > 0.0; })) {
+      throw std::invalid_argument("No routable pair carries traffic demand");
+    }
+
+    const auto& fragmentation = configuration->fragmentationStrategies;
+
+    absoluteFragmentation = fragmentation.at("absolute_fragmentation");
+
+    entropyFragmentation = fragmentation.at("entropy_based_fragmentation");
+
+    externalFragmentation = fragmentation.at("external_fragmentation");
+
+    // Bound to this kernel's streams and kept here, indexed by type ID, so
+    // kernels sharing one configuration never see each other's allocators.
+    std::vector<SpectrumAllocator> allocators;
+
+    for (const auto& requestType : configuration->requestTypes) {
+      allocators.push_back(SpectrumAllocatorFactory::CreateAllocator(
+          requestType.allocation,
+          prng->Stream(std::format("allocator.{}", requestType.type)),
+          configuration->spectrumSearch));
+    }
+
+    continuity = std::make_unique<ContinuityEngine>(
+        configuration->FSUsPerLink, configuration->spectrumSearch,
+        std::move(allocators));
+
+    Reset();
+  }
+
+  void Run(void) {
+    while (HasNext()) {
+      Next();
+    }
+  }
 
   void Reset(void) {
     statistics.Reset();
 
+    scheduler->clear();
+
+    requests.clear();
+
+    const auto links = configuration->graph.edge_count();
+
+    carriers.assign(links, Spectrum(configuration->FSUsPerLink));
+
+    absolute.assign(links, 0.0);
+
+    entropy.assign(links, 0.0);
+
+    external.assign(links, 0.0);
+
+    absoluteTotal.clear();
+
+    entropyTotal.clear();
+
+    externalTotal.clear();
+
+    stamps.assign(links, 0u);
+
+    epoch = 0u;
+
+    dirty.clear();
+
+    for (auto link = 0u; link < links; ++link) {
+      Touch(link);
+    }
+
     ignored_first_k = false;
 
     snapshots.clear();
 
-    requestsKeys.clear();
-
-    std::transform(configuration->requestTypes.begin(),
-                   configuration->requestTypes.end(),
-                   std::back_inserter(requestsKeys), [](auto& pair) {
-                     pair.second.blocking = 0;
+    // At most one sample per sampling period, so the whole history is
+    // reserved up front instead of regrown during the run.
+    if (configuration->samplingTime > 0u) {
+      snapshots.reserve(static_cast<uint64_t>(configuration->timeUnits /
+                                              configuration->samplingTime) +
+                        1u);
+    }
 
-                     pair.second.counting = 0;
+    counting.assign(configuration->requestTypes.size(), 0u);
 
-                     return pair.first;
-                   });
+    blocking.assign(configuration->requestTypes.size(), 0u);
 
     agent = AgentFactory::CreateAgent(configuration->agent);
 
-    prng = prng::PseudoRandomNumberGenerator::Instance();
-
-    prng->SetRandomSeed();
+    if (!agent) {
+      throw std::invalid_argument(
+          std::format("Unknown agent '{}'", configuration->agent));
+    }
 
-    prng->SetExponentialVariable("arrival", configuration->arrivalRate);
+    prng->SetSeed(seed);
 
-    prng->SetExponentialVariable("service", configuration->serviceRate);
+    arrival = prng->SetVariable<prng::ExponentialBlock>(
+        "arrival", configuration->arrivalRate);
 
-    prng->SetDiscreteVariable("fsus", configuration->probs.begin(),
-                              configuration->probs.end());
+    service = prng->SetVariable<prng::ExponentialBlock>(
+        "service", configuration->serviceRate);
 
-    prng->SetUniformVariable("routing", 0, configuration->graph.size());
+    fsus = prng->SetVariable<prng::Alias>(
+        "fsus", configuration->probs.begin(), configuration->probs.end());
 
-    router.SetStrategy(
-        std::make_shared<graph::RandomRouting>(configuration->graph));
+    pairs = prng->SetVariable<prng::Alias>("traffic", demand.begin(),
+                                           demand.end());
 
     ScheduleNextArrival();
   }
 
-  Implementation(std::shared_ptr<Configuration> configuration)
-      : k_to_ignore{0.1 * configuration->timeUnits},
-        configuration{configuration} {
-    for (const auto& [source, destination, cost] :
-         configuration->graph.get_edges()) {
-      const auto key = GenerateKeys(source, destination);
+  Document GetReport(void) const {
+    const auto time = std::time(nullptr);
+
+    const auto localtime = std::localtime(&time);
+
+    const auto kernel_time = statistics.time;
+
+    const auto requestCount = static_cast<double>(statistics.total_requests);
+
+    core::Document document;
+
+    document
+        .append("created at: {:02}/{:02}/{:04} {:02}h{:02}\n",
+                localtime->tm_mday, localtime->tm_mon + 1,
+                localtime->tm_year + 1900, localtime->tm_hour,
+                localtime->tm_min)
+        .append("seed: {}\n", prng->GetSeed())
+        .append("simulated time: {:.3f}\n", kernel_time)
+        .append("agent: {}\n", configuration->agent)
+        .append("scheduler: {}\n", configuration->scheduler)
+        .append("spectrum width (GHz): {:.2f}\n", configuration->spectrumWidth)
+        .append("slot width (GHz): {:.2f}\n", configuration->slotWidth)
+        .append("fsus per link: {}\n", configuration->FSUsPerLink);
+
+    const double load = configuration->arrivalRate / configuration->serviceRate;
+
+    document.append("load (E): {:.3f}\n", load)
+        .append("arrival rate: {:.3f}\n", configuration->arrivalRate)
+        .append("service rate: {:.3f}\n", configuration->serviceRate)
+        .append("grade of service: {:.3f}\n", statistics.GradeOfService())
+        .append("total requests: {}\n", requestCount);
 
-      carriers[key] = Spectrum(configuration->FSUsPerLink);
+    for (const auto& requestType : configuration->requestTypes) {
+      const auto ratio = counting[requestType.id] / requestCount;
+
+      const auto gos = blocking[requestType.id] / requestCount;
+
+      const auto normalized_load =
+          configuration->arrivalRate *
+          (static_cast<double>(requestType.FSUs) / configuration->FSUsPerLink);
+
+      document.append("requests for {} FSU(s)\n", requestType.FSUs)
+          .append("ratio: {:.3f}\n", ratio)
+          .append("grade of service: {:.3f}\n", gos)
+          .append("normalized load: {:.3f}\n", normalized_load);
     }
 
-    Reset();
+    return document;
   }
 
-  uint64_t GenerateKeys(const graph::Vertex source,
-                        const graph::Vertex destination) const {
-    return hash::CantorPairingFunction(source, destination);
-  }
+  void ExportDataset(const std::string& filename) const {
+    std::string buffer{
+        "time,absolute_fragmentation,entropy,external_fragmentation,grade_of_"
+        "service,slot_blocking_probability,active_requests\n"};
 
-  std::unordered_set<uint64_t> GenerateKeys(const graph::Route& route) const {
-    const auto& [vertices, cost] = route;
+    std::for_each(snapshots.begin(), snapshots.end(),
+                  [&buffer](const core::Statistics& snapshot) {
+                    buffer.append(std::format("{}\n", snapshot.Serialize()));
+                  });
 
-    std::unordered_set<uint64_t> keys;
+    std::ofstream stream(filename);
 
-    for (const auto& index : std::views::iota(1u, vertices.size())) {
-      const auto x = *std::next(vertices.begin(), index - 1);
+    if (!stream.is_open()) {
+      throw std::runtime_error(
+          std::format("Failed to write {} file", filename));
+    }
+
+    stream << buffer;
 
-      const auto y = *std::next(vertices.begin(), index);
+    stream.close();
+  }
 
-      keys.insert(hash::CantorPairingFunction(x, y));
+  void Touch(const graph::EdgeId link) {
+    if (stamps[link] == epoch + 1u) {
+      return;
     }
 
-    return keys;
-  }
+    stamps[link] = epoch + 1u;
 
-  bool Dispatch(Request& request) {
-    const auto keys = GenerateKeys(request.route);
+    dirty.push_back(link);
+  }
 
-    const auto first = *keys.begin();
+  void Dispatch(Request& request, const Slice& slice) {
+    request.slice = slice;
 
-    const auto slice =
-        request.type.allocator(carriers[first], request.type.FSUs);
+    for (const auto link : configuration->routes->path(request.path).links) {
+      carriers[link].allocate(slice);
 
-    if (!slice.has_value()) {
-      return false;
+      Touch(link);
     }
+  }
 
-    request.slice = slice.value();
+  void Release(const Request& request) {
+    for (const auto link : configuration->routes->path(request.path).links) {
+      carriers[link].deallocate(request.slice);
 
-    for (const auto& key : keys) {
-      if (carriers.at(key).available() < request.type.FSUs ||
-          !carriers.at(key).available_at(request.slice)) {
-        return false;
-      }
+      Touch(link);
     }
+  }
 
-    const auto allocate = [&](const auto key) {
-      carriers[key].allocate(request.slice);
-    };
+  static void Evaluate(const Fragmentation& strategy, const Spectrum& spectrum,
+                       double& cached, LinkSum& total) {
+    const auto value = strategy(spectrum);
 
-    std::for_each(keys.begin(), keys.end(), allocate);
+    total.replace(cached, value);
 
-    return true;
+    cached = value;
   }
 
-  void Release(Request& request) {
-    const auto keys = GenerateKeys(request.route);
+  void Sample(void) {
+    for (const auto link : dirty) {
+      Evaluate(*absoluteFragmentation, carriers[link], absolute[link],
+               absoluteTotal);
+
+      Evaluate(*entropyFragmentation, carriers[link], entropy[link],
+               entropyTotal);
+
+      Evaluate(*externalFragmentation, carriers[link], external[link],
+               externalTotal);
+    }
+
+    dirty.clear();
+
+    ++epoch;
+
+    statistics.absolute_fragmentation = absoluteTotal.value();
+
+    statistics.entropy_fragmentation = entropyTotal.value();
 
-    std::for_each(keys.begin(), keys.end(), [&](const auto key) {
-      carriers[key].deallocate(request.slice);
-    });
+    statistics.external_fragmentation = externalTotal.value();
   }
 
   void ScheduleNextArrival(void) {
-    auto& requestType =
-        configuration->requestTypes[requestsKeys[prng->Next("fsus")]];
+    const auto& requestType = configuration->requestTypes[fsus.Sample()];
 
-    ++requestType.counting;
+    ++counting[requestType.id];
 
-    auto request =
-        Request(router.compute(graph::NullVertex, graph::NullVertex).value());
+    const auto pair = pairs.Sample();
 
-    request.type = requestType;
+    const auto handle = requests.acquire(
+        Request(requestType, pair, configuration->routes->route(pair, 0u)));
 
-    queue.push(
-        Event::MakeArrival(statistics.time + prng->Next("arrival"), request));
+    scheduler->push(
+        Event::MakeArrival(statistics.time + arrival.Next(), handle));
 
-    statistics.total_FSUs_requested += request.type.FSUs;
+    statistics.total_FSUs_requested += requestType.FSUs;
 
     ++statistics.total_requests;
   }
 
   void ScheduleNextDeparture(const Event& event) {
-    const auto time = statistics.time + prng->Next("service");
+    const auto time = statistics.time + service.Next();
 
     const auto departure = Event::MakeDeparture(time, event.request);
 
-    queue.push(departure);
+    scheduler->push(departure);
   }
 
   bool HasNext(void) const {
-    return !queue.empty() && queue.top().time <= configuration->timeUnits;
+    return !scheduler->empty() &&
+           scheduler->top().time <= configuration->timeUnits;
   }
 
   void Next(void) {
-    auto event = queue.top();
+    const auto event = scheduler->pop();
 
-    queue.pop();
+    auto& request = requests[event.request];
 
     statistics.time = event.time;
 
@@ -228,11 +406,9 @@ struct Kernel::Implementation {
 
       statistics.Reset();
 
-      for (auto& request : configuration->requestTypes) {
-        request.second.blocking = 0u;
+      std::fill(counting.begin(), counting.end(), 0u);
 
-        request.second.counting = 0u;
-      }
+      std::fill(blocking.begin(), blocking.end(), 0u);
 
       configuration->logger->Info("Discard first {:.3f} time units",
                                   statistics.time);
@@ -242,165 +418,92 @@ struct Kernel::Implementation {
       --statistics.active_requests;
 
       configuration->logger->Info("Request for {} FSU(s) departing at {:.3f}",
-                                  event.request.type.FSUs, event.time);
+                                  request.type->FSUs, event.time);
+
+      Release(request);
 
-      Release(event.request);
+      requests.release(event.request);
 
       return;
     }
 
-    event.request.accepted = false;
+    request.accepted = false;
+
+    const auto& routes = *configuration->routes;
+
+    auto path = routes.path(request.path);
+
+    auto slice = continuity->Allocate(carriers, path.links, *request.type);
+
+    // With several routes per pair, the first one with a free slice, cheapest
+    // first, carries the request.
+    for (auto rank = 1u; !slice.has_value() && rank < routes.paths(); ++rank) {
+      const auto id = routes.route(request.pair, rank);
+
+      if (id == graph::NullPath) {
+        break;
+      }
+
+      request.path = id;
+
+      path = routes.path(id);
 
-    Environment environment{
-        .request = event.request,
+      slice = continuity->Allocate(carriers, path.links, *request.type);
+    }
+
+    const Environment environment{
+        .request = request,
+        .path = path,
         .carriers = carriers,
+        .trial = Trial(carriers),
+        .slice = slice,
         .activeRequests = statistics.active_requests,
         .FSUsPerLink = configuration->FSUsPerLink,
     };
 
-    if (this->agent->ShouldAccept(environment)) {
-      Dispatch(event.request);
+    if (slice.has_value() && this->agent->ShouldAccept(environment)) {
+      Dispatch(request, slice.value());
 
       ++statistics.active_requests;
 
       configuration->logger->Info("Accept request for {} FSU(s) at {:.3f}",
-                                  event.request.type.FSUs, statistics.time);
+                                  request.type->FSUs, statistics.time);
 
-      event.request.accepted = true;
+      request.accepted = true;
 
       ScheduleNextDeparture(event);
     } else {
       configuration->logger->Info("Blocking request for {} FSU(s) at {:.3f}",
-                                  event.request.type.FSUs, event.time);
-
-      statistics.total_FSUs_blocked += event.request.type.FSUs;
+                                  request.type->FSUs, event.time);
 
-      for (auto& [_, requestType] : configuration->requestTypes) {
-        if (event.request.type.FSUs != requestType.FSUs) {
-          continue;
-        }
+      statistics.total_FSUs_blocked += request.type->FSUs;
 
-        ++requestType.blocking;
-
-        break;
-      }
+      ++blocking[request.type->id];
 
       ++statistics.total_requests_blocked;
+
+      requests.release(event.request);
     }
 
     if (snapshots.empty() || abs(snapshots.back().time - event.time) >=
                                  configuration->samplingTime) {
-      statistics.absolute_fragmentation = 0.0;
-
-      statistics.entropy_fragmentation = 0.0;
-
-      statistics.external_fragmentation = 0.0;
-
-      const auto frag = configuration->fragmentationStrategies;
-
-      for (const auto& [source, destination, cost] :
-           configuration->graph.get_edges()) {
-        const auto key = GenerateKeys(source, destination);
-
-        statistics.absolute_fragmentation +=
-            (*(frag.at("absolute_fragmentation")))(carriers.at(key));
-
-        statistics.entropy_fragmentation +=
-            (*(frag.at("entropy_based_fragmentation")))(carriers.at(key));
-
-        statistics.external_fragmentation +=
-            (*(frag.at("external_fragmentation")))(carriers.at(key));
-      }
+      Sample();
 
       snapshots.push_back(statistics);
     }
 
     ScheduleNextArrival();
   }
-
-  Document GetReport(void) const {
-    const auto time = std::time(nullptr);
-
-    const auto localtime = std::localtime(&time);
-
-    const auto kernel_time = statistics.time;
-
-    const auto requestCount = static_cast<double>(statistics.total_requests);
-
-    core::Document document;
-
-    document
-        .append("created at: {:02}/{:02}/{:04} {:02}h{:02}\n",
-                localtime->tm_mday, localtime->tm_mon + 1,
-                localtime->tm_year + 1900, localtime->tm_hour,
-                localtime->tm_min)
-        .append("seed: {}\n", prng->GetSeed())
-        .append("simulated time: {:.3f}\n", kernel_time)
-        .append("agent: {}\n", configuration->agent)
-        .append("spectrum width (GHz): {:.2f}\n", configuration->spectrumWidth)
-        .append("slot width (GHz): {:.2f}\n", configuration->slotWidth)
-        .append("fsus per link: {}\n", configuration->FSUsPerLink);
-
-    const double load = configuration->arrivalRate / configuration->serviceRate;
-
-    document.append("load (E): {:.3f}\n", load)
-        .append("arrival rate: {:.3f}\n", configuration->arrivalRate)
-        .append("service rate: {:.3f}\n", configuration->serviceRate)
-        .append("grade of service: {:.3f}\n", statistics.GradeOfService())
-        .append("total requests: {}\n", requestCount);
-
-    for (const auto& [_, requestType] : configuration->requestTypes) {
-      const auto ratio = requestType.counting / requestCount;
-
-      const auto gos = requestType.blocking / requestCount;
-
-      const auto normalized_load =
-          configuration->arrivalRate *
-          (static_cast<double>(requestType.FSUs) / configuration->FSUsPerLink);
-
-      document.append("requests for {} FSU(s)\n", requestType.FSUs)
-          .append("ratio: {:.3f}\n", ratio)
-          .append("grade of service: {:.3f}\n", gos)
-          .append("normalized load: {:.3f}\n", normalized_load);
-    }
-
-    return document;
-  }
-
-  void ExportDataset(const std::string& filename) const {
-    std::string buffer{
-        "time,absolute_fragmentation,entropy,external_fragmentation,grade_of_"
-        "service,slot_blocking_probability,active_requests\n"};
-
-    std::for_each(snapshots.begin(), snapshots.end(),
-                  [&buffer](const core::Statistics& snapshot) {
-                    buffer.append(std::format("{}\n", snapshot.Serialize()));
-                  });
-
-    std::ofstream stream(filename);
-
-    if (!stream.is_open()) {
-      throw std::runtime_error(
-          std::format("Failed to write {} file", filename));
-    }
-
-    stream << buffer;
-
-    stream.close();
-  }
 };
 
-Kernel::Kernel(std::shared_ptr<Configuration> configuration) {
-  pImpl = std::make_unique<Implementation>(configuration);
+Kernel::Kernel(std::shared_ptr<Configuration> configuration,
+               const uint64_t seed) {
+  pImpl = std::make_unique<Implementation>(configuration, seed);
 }
 
 Kernel::~Kernel() {}
 
-void Kernel::Run(void) {
-  while (pImpl->HasNext()) {
-    pImpl->Next();
-  }
-}
+void Kernel::Run(void) { pImpl->Run(); }
 
 void Kernel::Reset(void) { pImpl->Reset(); }
 
@@ -1,9 +1,8 @@
 #pragma once
 
-#include <graph/router.h>
+#include <graph/table.h>
 #include <prng/prng.h>
 
-#include <queue>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -11,27 +10,10 @@
 #include "configuration.h"
 #include "document.h"
 #include "request.h"
+#include "scheduler.h"
 #include "spectrum.h"
 
 namespace core {
-struct Event final {
-  enum class Type { Arrival, Departure };
-
-  double time;
-  Type type;
-  Request request;
-
-  Event(void) = default;
-
-  Event(const double, const Type&, const Request&);
-
-  [[nodiscard]] bool operator<(const Event&) const noexcept;
-
-  [[nodiscard]] static Event MakeArrival(const double, const Request&);
-
-  [[nodiscard]] static Event MakeDeparture(const double, const Request&);
-};
-
 struct Statistics final {
   double absolute_fragmentation;
   double entropy_fragmentation;
@@ -62,9 +44,11 @@ struct Trace final {
   bool accepted;
 };
 
+// Runs one replication, with the agent, scheduler and allocators chosen at
+// run time from the configuration.
 class Kernel final {
  public:
-  Kernel(std::shared_ptr<Configuration>);
+  Kernel(std::shared_ptr<Configuration>, const uint64_t);
 
   ~Kernel();
 
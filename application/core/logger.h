@@ -2,6 +2,7 @@
 
 #include <format>
 #include <iostream>
+#include <string_view>
 #include <unordered_map>
 
 namespace core {
@@ -17,25 +18,25 @@ class Logger final {
   Logger(const bool enableLogging) : _enableLogging{enableLogging} {}
 
   template <typename... Args>
-  void Debug(const std::string& format, Args&&... args) {
+  void Debug(const std::string_view format, Args&&... args) {
     log(Logger::Level::Debug, format, args...);
     ;
   }
 
   template <typename... Args>
-  void Error(const std::string& format, Args&&... args) {
+  void Error(const std::string_view format, Args&&... args) {
     log(Logger::Level::Error, format, args...);
     ;
   }
 
   template <typename... Args>
-  void Info(const std::string& format, Args&&... args) {
+  void Info(const std::string_view format, Args&&... args) {
     log(Logger::Level::Info, format, args...);
     ;
   }
 
   template <typename... Args>
-  void Warning(const std::string& format, Args&&... args) {
+  void Warning(const std::string_view format, Args&&... args) {
     log(Logger::Level::Warning, format, args...);
     ;
   }
@@ -51,14 +52,14 @@ class Logger final {
   bool _enableLogging;
 
   template <typename... Args>
-  void log(Level level, const std::string& format, Args&&... args) {
+  void log(Level level, const std::string_view format, Args&&... args) {
     if (!_enableLogging) {
       return;
     }
 
     std::clog << std::format(
         "[{}] {}\n", _buffer.at(level),
-        std::vformat(format.c_str(), std::make_format_args(args...)));
+        std::vformat(format, std::make_format_args(args...)));
   }
 };
 }  // namespace core
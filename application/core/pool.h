@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+#include <vector>
+
+namespace core {
+struct Handle final {
+  uint32_t index;
+  uint32_t generation;
+
+  bool operator==(const Handle&) const = default;
+};
+
+// Slab of reusable records addressed by generation-checked handles. Released
+// slots are recycled in LIFO order and their generation is bumped, so a
+// handle kept past its release is detected instead of aliasing the new
+// occupant. Once the slab has grown to the peak population, acquire and
+// release never touch the heap.
+template <typename T>
+class Pool final {
+ public:
+  [[nodiscard]] Handle acquire(const T& value) {
+    if (available.empty()) {
+      slots.push_back(value);
+
+      generations.push_back(0u);
+
+      return Handle(static_cast<uint32_t>(slots.size() - 1u), 0u);
+    }
+
+    const auto index = available.back();
+
+    available.pop_back();
+
+    slots[index] = value;
+
+    return Handle(index, generations[index]);
+  }
+
+  void release(const Handle handle) {
+    assert(contains(handle));
+
+    ++generations[handle.index];
+
+    available.push_back(handle.index);
+  }
+
+  [[nodiscard]] bool contains(const Handle handle) const noexcept {
+    return handle.index < slots.size() &&
+           generations[handle.index] == handle.generation;
+  }
+
+  [[nodiscard]] T& at(const Handle handle) {
+    if (!contains(handle)) {
+      throw std::out_of_range(std::format("Stale handle {}:{}", handle.index,
+                                          handle.generation));
+    }
+
+    return slots[handle.index];
+  }
+
+  [[nodiscard]] const T& at(const Handle handle) const {
+    if (!contains(handle)) {
+      throw std::out_of_range(std::format("Stale handle {}:{}", handle.index,
+                                          handle.generation));
+    }
+
+    return slots[handle.index];
+  }
+
+  [[nodiscard]] T& operator[](const Handle handle) noexcept {
+    assert(contains(handle));
+
+    return slots[handle.index];
+  }
+
+  [[nodiscard]] const T& operator[](const Handle handle) const noexcept {
+    assert(contains(handle));
+
+    return slots[handle.index];
+  }
+
+  [[nodiscard]] uint64_t size(void) const noexcept {
+    return slots.size() - available.size();
+  }
+
+  [[nodiscard]] uint64_t capacity(void) const noexcept { return slots.size(); }
+
+  void clear(void) {
+    available.clear();
+
+    for (auto index = slots.size(); index > 0u; --index) {
+      ++generations[index - 1u];
+
+      available.push_back(static_cast<uint32_t>(index - 1u));
+    }
+  }
+
+ private:
+  std::vector<T> slots;
+  std::vector<uint32_t> generations;
+  std::vector<uint32_t> available;
+};
+}  // namespace core
@@ -2,11 +2,21 @@
 
 #include <array>
 #include <cassert>
+#include <limits>
 #include <ranges>
 #include <utility>
 
 namespace core {
-Request::Request(const graph::Route& route) : route{route} {}
+Request::Request(const RequestType& type, const uint64_t pair,
+                 const graph::PathId path)
+    : type{&type},
+      slice{0u, 0u},
+      path{path},
+      pair{static_cast<uint32_t>(pair)},
+      accepted{false} {
+  // The route table refuses graphs whose pair indices need more bits.
+  assert(pair <= std::numeric_limits<uint32_t>::max());
+}
 
 PassbandModulation::PassbandModulation(double slotWidth,
                                        uint64_t spectralEfficiency)
@@ -1,32 +1,41 @@
 #pragma once
 
-#include <graph/route.h>
+#include <graph/path.h>
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "spectrum.h"
 
 namespace core {
+// A request class. Classes are numbered densely in configuration order, and
+// the kernel keeps its per-class counters in arrays indexed by id.
 struct RequestType final {
   std::string type;
   std::string modulation;
-  SpectrumAllocator allocator;
+  std::string allocation;
+  std::optional<FitPolicy> policy;
   double bandwidth;
-  uint64_t blocking;
   uint64_t FSUs;
-  uint64_t counting;
+  uint32_t id;
 };
 
+// Requests only point at their class and name their path by ID: both outlive
+// every request (the former lives in the configuration, the latter in the
+// route table's path pool), so a request is a small trivially copyable record
+// that is cheap to pool. pair is the route table index of its endpoints, for
+// trying the pair's other routes.
 struct Request final {
-  RequestType type;
-  graph::Route route;
+  const RequestType* type;
   Slice slice;
+  graph::PathId path;
+  uint32_t pair;
   bool accepted;
 
   Request(void) = default;
 
-  Request(const graph::Route&);
+  Request(const RequestType&, const uint64_t, const graph::PathId);
 };
 
 struct Modulation {
@@ -0,0 +1,235 @@
+#include "scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace core {
+Event::Event(const double time, const Event::Type& type, const Handle request)
+    : time{time}, request{request}, type{type} {}
+
+bool Event::operator<(const Event& other) const noexcept {
+  return time > other.time;
+}
+
+Event Event::MakeArrival(const double time, const Handle request) {
+  return Event(time, Event::Type::Arrival, request);
+}
+
+Event Event::MakeDeparture(const double time, const Handle request) {
+  return Event(time, Event::Type::Departure, request);
+}
+
+void HeapScheduler::push(const Event& event) { queue.push(event); }
+
+Event HeapScheduler::pop(void) {
+  auto event = queue.top();
+
+  queue.pop();
+
+  return event;
+}
+
+const Event& HeapScheduler::top(void) const { return queue.top(); }
+
+bool HeapScheduler::empty(void) const noexcept { return queue.empty(); }
+
+uint64_t HeapScheduler::size(void) const noexcept { return queue.size(); }
+
+void HeapScheduler::clear(void) { queue = {}; }
+
+constexpr uint64_t MinBuckets = 2u;
+
+constexpr uint64_t WidthSamples = 25u;
+
+CalendarScheduler::CalendarScheduler(void)
+    : heads(MinBuckets, None), spare{None}, width{1.0}, count{0u}, day{0u} {}
+
+void CalendarScheduler::push(const Event& event) {
+  auto node = spare;
+
+  if (node == None) {
+    node = static_cast<uint32_t>(nodes.size());
+
+    nodes.push_back({event, None});
+  } else {
+    spare = nodes[node].next;
+
+    nodes[node].event = event;
+  }
+
+  Insert(node);
+
+  ++count;
+
+  day = std::min(day, DayOf(event.time));
+
+  if (count > 2u * heads.size()) {
+    Resize(2u * heads.size());
+  }
+}
+
+Event CalendarScheduler::pop(void) {
+  auto& head = heads[Locate()];
+
+  const auto node = head;
+
+  head = nodes[node].next;
+
+  nodes[node].next = spare;
+
+  spare = node;
+
+  --count;
+
+  if (heads.size() > MinBuckets && count < heads.size() / 2u) {
+    Resize(heads.size() / 2u);
+  }
+
+  return nodes[node].event;
+}
+
+const Event& CalendarScheduler::top(void) const {
+  return nodes[heads[Locate()]].event;
+}
+
+bool CalendarScheduler::empty(void) const noexcept { return count == 0u; }
+
+uint64_t CalendarScheduler::size(void) const noexcept { return count; }
+
+void CalendarScheduler::clear(void) {
+  nodes.clear();
+
+  heads.assign(MinBuckets, None);
+
+  spare = None;
+
+  width = 1.0;
+
+  count = 0u;
+
+  day = 0u;
+}
+
+uint64_t CalendarScheduler::DayOf(const double time) const noexcept {
+  return static_cast<uint64_t>(time / width);
+}
+
+uint64_t CalendarScheduler::Locate(void) const {
+  for (auto step = 0u; step < heads.size(); ++step, ++day) {
+    const auto head = heads[day % heads.size()];
+
+    if (head != None && DayOf(nodes[head].event.time) <= day) {
+      return day % heads.size();
+    }
+  }
+
+  // A whole year went by without a hit: the next event lies further in the
+  // future, so jump straight to the earliest one.
+  auto earliest = heads.size();
+
+  for (auto index = 0u; index < heads.size(); ++index) {
+    if (heads[index] == None) {
+      continue;
+    }
+
+    if (earliest == heads.size() || nodes[heads[index]].event.time <
+                                        nodes[heads[earliest]].event.time) {
+      earliest = index;
+    }
+  }
+
+  day = DayOf(nodes[heads[earliest]].event.time);
+
+  return earliest;
+}
+
+void CalendarScheduler::Insert(const uint32_t node) {
+  const auto time = nodes[node].event.time;
+
+  // Behind every event due no later, so simultaneous events leave in the
+  // order they were scheduled.
+  auto* link = &heads[DayOf(time) % heads.size()];
+
+  while (*link != None && nodes[*link].event.time <= time) {
+    link = &nodes[*link].next;
+  }
+
+  nodes[node].next = *link;
+
+  *link = node;
+}
+
+void CalendarScheduler::Resize(const uint64_t size) {
+  // Gathered bucket by bucket, so events due at the same time (which share a
+  // bucket) keep their relative order and are relinked behind one another.
+  order.clear();
+
+  times.clear();
+
+  for (const auto head : heads) {
+    for (auto node = head; node != None; node = nodes[node].next) {
+      order.push_back(node);
+
+      times.push_back(nodes[node].event.time);
+    }
+  }
+
+  const auto samples = std::min<uint64_t>(times.size(), WidthSamples);
+
+  std::partial_sort(times.begin(), times.begin() + samples, times.end());
+
+  const auto gap = [&](const uint64_t index) {
+    return times[index] - times[index - 1u];
+  };
+
+  if (samples > 1u) {
+    auto total = 0.0;
+
+    for (auto index = 1u; index < samples; ++index) {
+      total += gap(index);
+    }
+
+    const auto mean = total / static_cast<double>(samples - 1u);
+
+    // Ignore outliers so a few sparse events do not stretch the day.
+    auto sum = 0.0;
+
+    auto kept = 0u;
+
+    for (auto index = 1u; index < samples; ++index) {
+      if (gap(index) <= 2.0 * mean) {
+        sum += gap(index);
+
+        ++kept;
+      }
+    }
+
+    const auto estimate = kept ? 3.0 * sum / kept : 0.0;
+
+    if (std::isfinite(estimate) && estimate > 0.0) {
+      width = estimate;
+    }
+  }
+
+  heads.assign(size, None);
+
+  day = times.empty() ? 0u : DayOf(times.front());
+
+  for (const auto node : order) {
+    Insert(node);
+  }
+}
+
+std::unique_ptr<Scheduler> SchedulerFactory::CreateScheduler(
+    const std::string& type) {
+  if (type == "calendar") {
+    return std::make_unique<CalendarScheduler>();
+  }
+
+  if (type == "heap") {
+    return std::make_unique<HeapScheduler>();
+  }
+
+  return nullptr;
+}
+}  // namespace core
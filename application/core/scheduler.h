@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "pool.h"
+
+namespace core {
+// Events carry a handle into the kernel's request pool rather than the
+// request itself, keeping them small enough to shuffle around the queue.
+struct Event final {
+  enum class Type : uint8_t { Arrival, Departure };
+
+  double time;
+  Handle request;
+  Type type;
+
+  Event(void) = default;
+
+  Event(const double, const Type&, const Handle);
+
+  [[nodiscard]] bool operator<(const Event&) const noexcept;
+
+  [[nodiscard]] static Event MakeArrival(const double, const Handle);
+
+  [[nodiscard]] static Event MakeDeparture(const double, const Handle);
+};
+
+class Scheduler {
+ public:
+  virtual ~Scheduler() = default;
+
+  virtual void push(const Event&) = 0;
+
+  virtual Event pop(void) = 0;
+
+  [[nodiscard]] virtual const Event& top(void) const = 0;
+
+  [[nodiscard]] virtual bool empty(void) const noexcept = 0;
+
+  [[nodiscard]] virtual uint64_t size(void) const noexcept = 0;
+
+  virtual void clear(void) = 0;
+};
+
+class HeapScheduler final : public Scheduler {
+ public:
+  void push(const Event&) override;
+
+  Event pop(void) override;
+
+  [[nodiscard]] const Event& top(void) const override;
+
+  [[nodiscard]] bool empty(void) const noexcept override;
+
+  [[nodiscard]] uint64_t size(void) const noexcept override;
+
+  void clear(void) override;
+
+ private:
+  std::priority_queue<Event> queue;
+};
+
+// Calendar queue (R. Brown, 1988): events are hashed by time into buckets
+// one "day" wide and dequeued by sweeping the buckets in time order. The
+// bucket count doubles/halves with the population and the day width is
+// re-estimated from the head of the queue on every resize, which keeps
+// enqueue and dequeue at amortized O(1) for smooth holding-time laws such
+// as the exponential.
+class CalendarScheduler final : public Scheduler {
+ public:
+  CalendarScheduler(void);
+
+  void push(const Event&) override;
+
+  Event pop(void) override;
+
+  [[nodiscard]] const Event& top(void) const override;
+
+  [[nodiscard]] bool empty(void) const noexcept override;
+
+  [[nodiscard]] uint64_t size(void) const noexcept override;
+
+  void clear(void) override;
+
+ private:
+  static constexpr auto None = std::numeric_limits<uint32_t>::max();
+
+  struct Node final {
+    Event event;
+    uint32_t next;
+  };
+
+  // Each bucket is a list threaded through nodes, kept sorted by ascending
+  // time so its earliest event is at the head. Released nodes are chained
+  // from spare and reused, and a resize relinks the nodes in place, so once
+  // the queue has reached its peak population it never touches the heap.
+  std::vector<Node> nodes;
+  std::vector<uint32_t> heads;
+  std::vector<uint32_t> order;
+  std::vector<double> times;
+  uint32_t spare;
+  double width;
+  uint64_t count;
+  mutable uint64_t day;
+
+  [[nodiscard]] uint64_t DayOf(const double) const noexcept;
+
+  [[nodiscard]] uint64_t Locate(void) const;
+
+  void Insert(const uint32_t);
+
+  void Resize(const uint64_t);
+};
+
+class SchedulerFactory final {
+ public:
+  [[nodiscard]] static std::unique_ptr<Scheduler> CreateScheduler(
+      const std::string&);
+};
+}  // namespace core
@@ -1,44 +1,133 @@
 #include "spectrum.h"
 
-#include <prng/prng.h>
-
 #include <algorithm>
+#include <bit>
+#include <cmath>
+#include <format>
+#include <iterator>
 #include <limits>
-#include <numeric>
-#include <random>
 #include <ranges>
+#include <stdexcept>
 
 namespace core {
 uint64_t size(const Slice& slice) { return slice.second - slice.first + 1; }
 
+// Sets or clears FSUs start to end in a packed bitmap.
+static void Mark(std::vector<uint64_t>& bitmap, const uint64_t start,
+                 const uint64_t end, const bool value) {
+  for (auto word = start / 64u; word <= end / 64u; ++word) {
+    const auto first = word == start / 64u ? start % 64u : 0u;
+
+    const auto last = word == end / 64u ? end % 64u : 63u;
+
+    const auto mask = (~0ull >> (63u - last)) & (~0ull << first);
+
+    bitmap[word] = value ? bitmap[word] | mask : bitmap[word] & ~mask;
+  }
+}
+
+// length * ln(length) in 32.32 fixed point.
+static int64_t Shannon(const uint64_t length) {
+  const auto value = static_cast<double>(length);
+
+  return std::llround(std::ldexp(value * std::log(value), 32));
+}
+
 Spectrum::Spectrum(const uint64_t FSUsPerLink)
-    : resources(std::vector(FSUsPerLink, FSU(false, 0u))) {
+    : allocated((FSUsPerLink + 63u) / 64u, 0u),
+      occupancy(FSUsPerLink, 0u),
+      tree(2u * std::bit_ceil(FSUsPerLink), 0u),
+      runs(FSUsPerLink + 1u, 0u) {
+  if (FSUsPerLink % 64u) {
+    allocated.back() = ~0ull << (FSUsPerLink % 64u);
+  }
+
+  Reserve();
+
   slices.push_back({0, FSUsPerLink - 1});
+
+  Track(slices.back(), true);
+}
+
+// At most every other FSU starts a free run. Growing the run arrays straight
+// to that bound, before any iterator into them is taken, means a spectrum (or
+// a copy of one, which only gets what it holds) reallocates them at most once.
+void Spectrum::Reserve(void) {
+  const auto bound = (size() + 1u) / 2u;
+
+  if (slices.capacity() < bound || sizes.capacity() < bound) {
+    slices.reserve(bound);
+
+    sizes.reserve(bound);
+  }
+}
+
+// Runs must be removed before the runs replacing them are added, as both may
+// start at the same FSU.
+void Spectrum::Track(const Slice& run, const bool added) {
+  const auto length = core::size(run);
+
+  const std::pair key(length, run.first);
+
+  const auto iterator = std::lower_bound(sizes.begin(), sizes.end(), key);
+
+  if (added) {
+    sizes.insert(iterator, key);
+
+    ++runs[length];
+
+    free += length;
+
+    shannon += Shannon(length);
+  } else {
+    sizes.erase(iterator);
+
+    --runs[length];
+
+    free -= length;
+
+    shannon -= Shannon(length);
+  }
+
+  auto node = tree.size() / 2u + run.first;
+
+  tree[node] = added ? static_cast<uint32_t>(length) : 0u;
+
+  for (node /= 2u; node; node /= 2u) {
+    tree[node] = std::max(tree[2u * node], tree[2u * node + 1u]);
+  }
 }
 
 void Spectrum::allocate(const Slice& slice) {
   const auto& [start, end] = slice;
 
-  for (const auto index : std::ranges::views::iota(start, end + 1u)) {
-    auto& [allocated, occupancy] = resources[index];
+  if (journaling) {
+    journal.emplace_back(slice, true);
+  }
 
-    allocated = true;
+  Reserve();
 
-    ++occupancy;
-  }
+  Mark(allocated, start, end, true);
 
-  auto iterator =
-      std::ranges::find_if(slices, [&](const Slice& availableSlice) {
-        const auto [i, j] = availableSlice;
+  for (const auto index : std::ranges::views::iota(start, end + 1u)) {
+    ++occupancy[index];
+  }
 
-        return i <= start && end <= j;
-      });
+  // The only run that can hold the slice is the last one starting at or
+  // before it.
+  auto iterator = std::upper_bound(
+      slices.begin(), slices.end(), start,
+      [](const uint64_t index, const Slice& run) { return index < run.first; });
 
-  if (iterator == slices.end()) {
+  if (iterator == slices.begin() || std::prev(iterator)->second < end) {
     return;
   }
 
-  const auto& [iteratorStart, iteratorEnd] = *iterator;
+  --iterator;
+
+  const auto [iteratorStart, iteratorEnd] = *iterator;
+
+  Track(*iterator, false);
 
   if (start == iteratorStart && end == iteratorEnd) {
     slices.erase(iterator);
@@ -49,12 +138,16 @@ void Spectrum::allocate(const Slice& slice) {
   if (start == iteratorStart) {
     *iterator = Slice(end + 1, iteratorEnd);
 
+    Track(*iterator, true);
+
     return;
   }
 
   if (end == iteratorEnd) {
     *iterator = Slice(iteratorStart, start - 1);
 
+    Track(*iterator, true);
+
     return;
   }
 
@@ -62,6 +155,10 @@ void Spectrum::allocate(const Slice& slice) {
 
   const Slice after(end + 1, iteratorEnd);
 
+  Track(before, true);
+
+  Track(after, true);
+
   *iterator = before;
 
   slices.insert(iterator + 1, after);
@@ -70,194 +167,421 @@ void Spectrum::allocate(const Slice& slice) {
 void Spectrum::deallocate(const Slice& slice) {
   const auto& [start, end] = slice;
 
-  for (const auto index : std::ranges::views::iota(start, end + 1u)) {
-    auto& [allocated, occupancy] = resources[index];
-
-    allocated = false;
+  if (journaling) {
+    journal.emplace_back(slice, false);
   }
 
-  auto iterator = std::lower_bound(
+  Reserve();
+
+  Mark(allocated, start, end, false);
+
+  const auto next = std::lower_bound(
       slices.begin(), slices.end(), slice,
       [](const Slice& a, const Slice& b) { return a.second < b.first; });
 
-  bool merged_previous = false;
+  const auto mergesNext = next != slices.end() && end + 1 == next->first;
 
-  if (iterator != slices.begin()) {
-    auto& [iteratorStart, iteratorEnd] = *(iterator - 1);
+  const auto mergesPrevious =
+      next != slices.begin() && std::prev(next)->second + 1 == start;
 
-    if (iteratorEnd + 1 == start) {
-      iteratorEnd = end;
+  if (mergesPrevious && mergesNext) {
+    Track(*std::prev(next), false);
 
-      merged_previous = true;
+    Track(*next, false);
 
-      iterator = iterator - 1;
-    }
+    std::prev(next)->second = next->second;
+
+    Track(*std::prev(next), true);
+
+    slices.erase(next);
+
+    return;
   }
 
-  auto& [iteratorStart, iteratorEnd] = *iterator;
+  if (mergesPrevious) {
+    Track(*std::prev(next), false);
 
-  if (iterator != slices.end() && end + 1 == iteratorStart) {
-    if (merged_previous) {
-      iteratorStart = (iterator - 1)->first;
+    std::prev(next)->second = end;
 
-      iterator = slices.erase(iterator - 1);
+    Track(*std::prev(next), true);
 
-      return;
-    }
+    return;
+  }
+
+  if (mergesNext) {
+    Track(*next, false);
+
+    next->first = start;
 
-    iteratorStart = start;
+    Track(*next, true);
+
+    return;
   }
 
-  if (!merged_previous) {
-    slices.insert(iterator, slice);
+  Track(slice, true);
+
+  slices.insert(next, slice);
+}
+
+uint64_t Spectrum::size(void) const noexcept { return occupancy.size(); }
+
+uint64_t Spectrum::available(void) const noexcept { return free; }
+
+uint64_t Spectrum::largest_available(void) const noexcept {
+  return sizes.empty() ? 0u : sizes.back().first;
+}
+
+std::optional<Slice> Spectrum::first_available(
+    const uint64_t FSUs) const noexcept {
+  if (tree[1] < FSUs) {
+    return std::nullopt;
+  }
+
+  uint64_t node = 1u;
+
+  while (node < tree.size() / 2u) {
+    node = tree[2u * node] >= FSUs ? 2u * node : 2u * node + 1u;
+  }
+
+  const auto start = node - tree.size() / 2u;
+
+  return Slice(start, start + tree[node] - 1u);
+}
+
+std::optional<Slice> Spectrum::last_available(
+    const uint64_t FSUs) const noexcept {
+  if (tree[1] < FSUs) {
+    return std::nullopt;
   }
+
+  uint64_t node = 1u;
+
+  while (node < tree.size() / 2u) {
+    node = tree[2u * node + 1u] >= FSUs ? 2u * node + 1u : 2u * node;
+  }
+
+  const auto start = node - tree.size() / 2u;
+
+  return Slice(start, start + tree[node] - 1u);
 }
 
-uint64_t Spectrum::size(void) const noexcept { return resources.size(); }
+std::optional<Slice> Spectrum::smallest_available(
+    const uint64_t FSUs) const noexcept {
+  const auto iterator = std::lower_bound(
+      sizes.begin(), sizes.end(), std::pair<uint64_t, uint64_t>(FSUs, 0u));
 
-uint64_t Spectrum::available(void) const noexcept {
-  return std::accumulate(slices.begin(), slices.end(), 0,
-                         [](const int sum, const Slice& slice) {
-                           const auto [start, end] = slice;
+  if (iterator == sizes.end()) {
+    return std::nullopt;
+  }
+
+  const auto [length, start] = *iterator;
 
-                           return sum + end - start + 1;
-                         });
+  return Slice(start, start + length - 1u);
+}
+
+double Spectrum::entropy(const uint64_t minFSUs) const noexcept {
+  // With r = length / N, -sum(r ln r) = (F ln N - sum(length ln length)) / N
+  // where F is the free FSUs the sum covers. Runs below the threshold are
+  // taken back out, which costs O(minFSUs) regardless of the link state.
+  auto sum = shannon;
+
+  auto covered = free;
+
+  for (auto length = 1u; length < std::min<uint64_t>(minFSUs, runs.size());
+       ++length) {
+    sum -= runs[length] * Shannon(length);
+
+    covered -= runs[length] * length;
+  }
+
+  const auto FSUs = static_cast<double>(size());
+
+  return (static_cast<double>(covered) * std::log(FSUs) -
+          std::ldexp(static_cast<double>(sum), -32)) /
+         FSUs;
+}
+
+uint64_t Spectrum::count_available(const uint64_t FSUs) const noexcept {
+  const auto iterator = std::lower_bound(
+      sizes.begin(), sizes.end(), std::pair<uint64_t, uint64_t>(FSUs, 0u));
+
+  return static_cast<uint64_t>(sizes.end() - iterator);
+}
+
+Slice Spectrum::nth_available(const uint64_t FSUs,
+                              const uint64_t n) const noexcept {
+  const auto [length, start] = sizes[sizes.size() - count_available(FSUs) + n];
+
+  return Slice(start, start + length - 1u);
 }
 
 bool Spectrum::available_at(const Slice& slice) const noexcept {
   const auto& [start, end] = slice;
 
-  const auto iterator = std::find_if(
-      slices.begin(), slices.end(), [&](const Slice& availableSlice) {
-        const auto [availableStart, availableEnd] = availableSlice;
+  if (start > end || end >= size()) {
+    return false;
+  }
 
-        return start + end <= availableStart + availableEnd;
-      });
+  for (auto word = start / 64u; word <= end / 64u; ++word) {
+    const auto first = word == start / 64u ? start % 64u : 0u;
 
-  return iterator != slices.end();
+    const auto last = word == end / 64u ? end % 64u : 63u;
+
+    const auto mask = (~0ull >> (63u - last)) & (~0ull << first);
+
+    if (allocated[word] & mask) {
+      return false;
+    }
+  }
+
+  return true;
 }
 
-std::vector<Slice> Spectrum::available_slices(void) const noexcept {
+std::span<const Slice> Spectrum::available_slices(void) const noexcept {
   return slices;
 }
 
 std::string Spectrum::Serialize(void) const noexcept {
   std::string buffer;
 
-  std::for_each(resources.begin(), resources.end(),
-                [&buffer](const FSU& resource) {
-                  const auto& [allocated, occupancy] = resource;
-
-                  buffer.append(allocated ? "#" : ".");
-                });
+  for (auto index = 0u; index < size(); ++index) {
+    buffer.append(at(index).allocated ? "#" : ".");
+  }
 
   return buffer;
 }
 
-FSU Spectrum::at(const uint64_t index) const { return resources.at(index); }
+FSU Spectrum::at(const uint64_t index) const {
+  const auto count = occupancy.at(index);
 
-std::optional<Slice> BestFit(const Spectrum& spectrum, const uint64_t FSUs) {
-  const auto fit = [&](const uint64_t size) { return FSUs <= size; };
+  return FSU((allocated[index / 64u] >> (index % 64u)) & 1u, count);
+}
 
-  const auto slices = spectrum.available_slices();
+std::span<const uint64_t> Spectrum::bitmap(void) const noexcept {
+  return allocated;
+}
 
-  auto buffer = slices | std::views::transform(size) | std::views::filter(fit);
+void Spectrum::assign(std::span<const uint64_t> bitmap) {
+  std::copy(bitmap.begin(), bitmap.end(), allocated.begin());
 
-  const auto iterator = std::min_element(buffer.begin(), buffer.end());
+  Reserve();
 
-  if (iterator == buffer.end()) {
-    return std::nullopt;
+  slices.clear();
+
+  sizes.clear();
+
+  std::fill(tree.begin(), tree.end(), 0u);
+
+  std::fill(runs.begin(), runs.end(), 0u);
+
+  free = 0u;
+
+  shannon = 0;
+
+  for (auto index = 0u; index < size();) {
+    const auto word = allocated[index / 64u] >> (index % 64u);
+
+    if (word & 1u) {
+      index += std::min<uint64_t>(std::countr_one(word), 64u - index % 64u);
+
+      continue;
+    }
+
+    const auto length =
+        std::min<uint64_t>(std::countr_zero(word), 64u - index % 64u);
+
+    if (!slices.empty() && slices.back().second + 1u == index) {
+      slices.back().second += length;
+    } else {
+      slices.emplace_back(index, index + length - 1u);
+    }
+
+    index += length;
   }
 
-  const auto min = *iterator;
+  for (const auto& run : slices) {
+    Track(run, true);
+  }
+}
 
-  const auto minSize = [&](const Slice& slice) { return size(slice) == min; };
+void Spectrum::begin_transaction(void) {
+  if (journaling) {
+    throw std::logic_error("Spectrum transaction already open");
+  }
 
-  const auto& [start, _] = *std::ranges::find_if(slices, minSize);
+  journaling = true;
+}
 
-  return Slice(start, start + FSUs - 1);
+void Spectrum::commit(void) noexcept {
+  journaling = false;
+
+  journal.clear();
 }
 
-std::optional<Slice> FirstFit(const Spectrum& spectrum, const uint64_t FSUs) {
-  const auto slices = spectrum.available_slices();
+void Spectrum::rollback(void) {
+  journaling = false;
 
-  const auto iterator =
-      std::find_if(slices.begin(), slices.end(), [=](const Slice& slice) {
-        const auto [start, end] = slice;
+  for (auto iterator = journal.rbegin(); iterator != journal.rend();
+       ++iterator) {
+    const auto& [slice, allocated] = *iterator;
 
-        return start + FSUs - 1 <= end;
-      });
+    if (allocated) {
+      deallocate(slice);
+    } else {
+      allocate(slice);
+    }
 
-  if (iterator == slices.end()) {
+    // Allocation bumps occupancy and deallocation leaves it alone, so after
+    // either inverse the slice sits one above its pre-journal count.
+    for (const auto index :
+         std::ranges::views::iota(slice.first, slice.second + 1u)) {
+      --occupancy[index];
+    }
+  }
+
+  journal.clear();
+}
+
+bool Spectrum::in_transaction(void) const noexcept { return journaling; }
+
+std::optional<Slice> BestFit(const Spectrum& spectrum, const uint64_t FSUs) {
+  const auto run = spectrum.smallest_available(FSUs);
+
+  if (!run.has_value()) {
     return std::nullopt;
   }
 
-  const auto& [start, _] = *iterator;
+  return Slice(run->first, run->first + FSUs - 1);
+}
 
-  return Slice(start, start + FSUs - 1);
+std::optional<Slice> FirstFit(const Spectrum& spectrum, const uint64_t FSUs) {
+  const auto run = spectrum.first_available(FSUs);
+
+  if (!run.has_value()) {
+    return std::nullopt;
+  }
+
+  return Slice(run->first, run->first + FSUs - 1);
 }
 
 std::optional<Slice> LastFit(const Spectrum& spectrum, const uint64_t FSUs) {
-  const auto slices = spectrum.available_slices();
+  const auto run = spectrum.last_available(FSUs);
 
-  const auto iterator =
-      std::find_if(slices.rbegin(), slices.rend(), [=](const Slice& slice) {
-        const auto [start, end] = slice;
+  if (!run.has_value()) {
+    return std::nullopt;
+  }
 
-        return start + FSUs - 1 <= end;
-      });
+  return Slice(run->first, run->first + FSUs - 1);
+}
 
-  if (iterator == slices.rend()) {
+std::optional<Slice> RandomFit(const Spectrum& spectrum, const uint64_t FSUs,
+                               prng::Engine& engine) {
+  // Every run that fits is equally likely; the size index counts and
+  // addresses them directly.
+  const auto candidates = spectrum.count_available(FSUs);
+
+  if (!candidates) {
     return std::nullopt;
   }
 
-  const auto& [start, _] = *iterator;
+  const auto [start, _] = spectrum.nth_available(FSUs, engine.Below(candidates));
 
   return Slice(start, start + FSUs - 1);
 }
 
-std::optional<Slice> RandomFit(const Spectrum& spectrum, const uint64_t FSUs) {
-  const auto predicate = [&](const Slice& slice) {
-    return FSUs <= size(slice);
-  };
-
-  auto filter = spectrum.available_slices() | std::views::filter(predicate);
+std::optional<Slice> WorstFit(const Spectrum& spectrum, const uint64_t FSUs) {
+  const auto largest = spectrum.largest_available();
 
-  if (filter.empty()) {
+  if (largest < FSUs) {
     return std::nullopt;
   }
 
-  std::vector<Slice> buffer(filter.begin(), filter.end());
+  // The shortest run at least as long as the longest is the lowest longest.
+  const auto run = spectrum.smallest_available(largest);
+
+  return Slice(run->first, run->first + FSUs - 1);
+}
 
-  auto prng = prng::PseudoRandomNumberGenerator::Instance();
+// Deterministic policy: the list-based function, or a bitmap search.
+static SpectrumAllocator Deterministic(const SpectrumAllocator& list,
+                                       const FitPolicy policy,
+                                       const SpectrumSearch search) {
+  if (search == SpectrumSearch::List) {
+    return list;
+  }
 
-  prng->SetUniformVariable("random_fit", 0, buffer.size());
+  return [=](const Spectrum& spectrum,
+             const uint64_t FSUs) -> std::optional<Slice> {
+    const auto start = FindFreeRun(spectrum.bitmap(), FSUs, policy, search);
 
-  const auto index = static_cast<uint64_t>(prng->Next("random_fit"));
+    if (!start.has_value()) {
+      return std::nullopt;
+    }
 
-  return buffer[index];
+    return Slice(start.value(), start.value() + FSUs - 1);
+  };
 }
 
-std::optional<Slice> WorstFit(const Spectrum& spectrum, const uint64_t FSUs) {
-  const auto fit = [&](const uint64_t size) { return FSUs <= size; };
-
-  const auto slices = spectrum.available_slices();
+static const std::unordered_map<
+    std::string,
+    std::function<SpectrumAllocator(prng::Engine&, const SpectrumSearch)>>
+    spectrumAllocationStrategies{
+        {"best-fit",
+         [](prng::Engine&, const SpectrumSearch search) {
+           return Deterministic(BestFit, FitPolicy::Best, search);
+         }},
+        {"first-fit",
+         [](prng::Engine&, const SpectrumSearch search) {
+           return Deterministic(FirstFit, FitPolicy::First, search);
+         }},
+        {"last-fit",
+         [](prng::Engine&, const SpectrumSearch search) {
+           return Deterministic(LastFit, FitPolicy::Last, search);
+         }},
+        {"random-fit",
+         [](prng::Engine& engine, const SpectrumSearch) -> SpectrumAllocator {
+           return [&engine](const Spectrum& spectrum, const uint64_t FSUs) {
+             return RandomFit(spectrum, FSUs, engine);
+           };
+         }},
+        {"worst-fit",
+         [](prng::Engine&, const SpectrumSearch search) {
+           return Deterministic(WorstFit, FitPolicy::Worst, search);
+         }},
+    };
+
+bool SpectrumAllocatorFactory::Contains(const std::string& type) {
+  return spectrumAllocationStrategies.contains(type);
+}
 
-  auto buffer = slices | std::views::transform(size) | std::views::filter(fit);
+std::optional<FitPolicy> SpectrumAllocatorFactory::Policy(
+    const std::string& type) {
+  static const std::unordered_map<std::string, FitPolicy> policies{
+      {"best-fit", FitPolicy::Best},
+      {"first-fit", FitPolicy::First},
+      {"last-fit", FitPolicy::Last},
+      {"worst-fit", FitPolicy::Worst},
+  };
 
-  const auto iterator = std::max_element(buffer.begin(), buffer.end());
+  const auto iterator = policies.find(type);
 
-  if (iterator == buffer.end()) {
+  if (iterator == policies.end()) {
     return std::nullopt;
   }
 
-  const auto max = *iterator;
+  return iterator->second;
+}
 
-  const auto maxSize = [&](const Slice& slice) { return size(slice) == max; };
+SpectrumAllocator SpectrumAllocatorFactory::CreateAllocator(
+    const std::string& type, prng::Engine& engine,
+    const SpectrumSearch search) {
+  const auto iterator = spectrumAllocationStrategies.find(type);
 
-  const auto& [start, _] = *std::ranges::find_if(slices, maxSize);
+  if (iterator == spectrumAllocationStrategies.end()) {
+    throw std::invalid_argument(std::format("Unknown allocator '{}'", type));
+  }
 
-  return Slice(start, start + FSUs - 1);
+  return iterator->second(engine, search);
 }
 
 double AbsoluteFragmentation::operator()(const Spectrum& spectrum) const {
@@ -265,9 +589,7 @@ double AbsoluteFragmentation::operator()(const Spectrum& spectrum) const {
     return .0f;
   }
 
-  const auto buffer = spectrum.available_slices() | std::views::transform(size);
-
-  const auto max = *std::max_element(buffer.begin(), buffer.end());
+  const auto max = spectrum.largest_available();
 
   return 1.f - max / static_cast<double>(spectrum.available());
 }
@@ -277,9 +599,7 @@ double ExternalFragmentation::operator()(const Spectrum& spectrum) const {
     return .0f;
   }
 
-  const auto buffer = spectrum.available_slices() | std::views::transform(size);
-
-  const auto max = *std::max_element(buffer.begin(), buffer.end());
+  const auto max = spectrum.largest_available();
 
   return 1.f - max / static_cast<double>(spectrum.size());
 }
@@ -292,22 +612,34 @@ double EntropyBasedFragmentation::operator()(const Spectrum& spectrum) const {
     return std::numeric_limits<double>::max();
   }
 
-  const auto fit = [&](const uint64_t size) { return minFSUs <= size; };
+  return spectrum.entropy(minFSUs);
+}
 
-  const auto FSUs = static_cast<double>(spectrum.size());
+// What EntropyBasedFragmentation reports for a full link.
+constexpr auto Saturation = std::numeric_limits<double>::max();
 
-  const auto ratio = [&](const uint64_t& size) {
-    return static_cast<double>(size) / FSUs;
-  };
+void LinkSum::add(const double term, const int64_t sign) noexcept {
+  if (term == Saturation) {
+    saturated += static_cast<uint64_t>(sign);
+  } else {
+    sum += sign * std::llround(std::ldexp(term, 32));
+  }
+}
 
-  const auto shannon = [&](const double& ratio) {
-    return ratio * std::log(ratio);
-  };
+void LinkSum::replace(const double previous, const double current) noexcept {
+  add(previous, -1);
+
+  add(current, 1);
+}
+
+double LinkSum::value(void) const noexcept {
+  return std::ldexp(static_cast<double>(sum), -32) +
+         static_cast<double>(saturated) * Saturation;
+}
 
-  auto buffer = spectrum.available_slices() | std::views::transform(size) |
-                std::views::filter(fit) | std::views::transform(ratio) |
-                std::views::transform(shannon);
+void LinkSum::clear(void) noexcept {
+  sum = 0;
 
-  return -std::accumulate(buffer.begin(), buffer.end(), .0f);
+  saturated = 0u;
 }
 }  // namespace core
@@ -1,13 +1,18 @@
 #pragma once
 
+#include <prng/engine.h>
+
 #include <functional>
 #include <limits>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "bitmap.h"
+
 namespace core {
 struct FSU final {
   bool allocated;
@@ -36,18 +41,86 @@ class Spectrum final {
 
   [[nodiscard]] bool available_at(const Slice&) const noexcept;
 
-  [[nodiscard]] std::vector<Slice> available_slices(void) const noexcept;
+  // Length of the largest free run, or zero on a full link.
+  [[nodiscard]] uint64_t largest_available(void) const noexcept;
+
+  // Free-run index queries, all O(log n), for runs of at least the given
+  // length: the lowest one, the highest one, and the shortest one (the lowest
+  // among equally short runs). Each returns the whole run.
+  [[nodiscard]] std::optional<Slice> first_available(
+      const uint64_t) const noexcept;
+
+  [[nodiscard]] std::optional<Slice> last_available(
+      const uint64_t) const noexcept;
+
+  [[nodiscard]] std::optional<Slice> smallest_available(
+      const uint64_t) const noexcept;
+
+  // Number of free runs of at least the given length, in O(log n), and the
+  // n-th of them in (length, start) order, for uniform draws among them.
+  [[nodiscard]] uint64_t count_available(const uint64_t) const noexcept;
+
+  [[nodiscard]] Slice nth_available(const uint64_t,
+                                    const uint64_t) const noexcept;
+
+  // Shannon entropy -sum(r * ln r) of the free runs of at least the given
+  // length, each weighted by its share r of the link.
+  [[nodiscard]] double entropy(const uint64_t) const noexcept;
+
+  // Free runs in ascending order, without copying. The view is invalidated by
+  // the next allocate, deallocate, assign or rollback.
+  [[nodiscard]] std::span<const Slice> available_slices(void) const noexcept;
 
   [[nodiscard]] std::string Serialize(void) const noexcept;
 
   [[nodiscard]] FSU at(const uint64_t) const;
 
+  // Packed allocation state, in the layout FindFreeRun expects.
+  [[nodiscard]] std::span<const uint64_t> bitmap(void) const noexcept;
+
+  // Replaces the allocation state with a bitmap of the same layout and
+  // rebuilds the free-run list, reusing its storage. Occupancy is untouched.
+  void assign(std::span<const uint64_t>);
+
+  // What-if evaluation without copying: once a transaction is open, allocate
+  // and deallocate are journaled, rollback undoes them in reverse order and
+  // commit keeps them. Journaled allocations must target free FSUs.
+  void begin_transaction(void);
+
+  void commit(void) noexcept;
+
+  void rollback(void);
+
+  [[nodiscard]] bool in_transaction(void) const noexcept;
+
  private:
-  std::vector<FSU> resources;
+  std::vector<uint64_t> allocated;
+  std::vector<uint64_t> occupancy;
   std::vector<Slice> slices;
+  std::vector<std::pair<Slice, bool>> journal;
+  bool journaling = false;
+
+  // Index and aggregates over slices, updated with every run added to or
+  // removed from it. Runs are kept sorted by (length, start) in sizes, and a
+  // max tree over positions holds each run's length at its start FSU, so the
+  // fit queries are binary searches or tree descents. The fragmentation
+  // measures read the free FSU count, the number of runs of each length and
+  // the sum of length * ln(length) in 32.32 fixed point, which keeps it exact
+  // whatever order the updates come in. Everything is flat and sized by the
+  // link, so updates never allocate once the run arrays have grown.
+  std::vector<std::pair<uint64_t, uint64_t>> sizes;
+  std::vector<uint32_t> tree;
+  std::vector<uint32_t> runs;
+  uint64_t free = 0u;
+  int64_t shannon = 0;
+
+  void Reserve(void);
+
+  void Track(const Slice&, const bool);
 };
 
-using Carriers = std::unordered_map<uint64_t, Spectrum>;
+// Link state, one spectrum per graph::EdgeId.
+using Carriers = std::vector<Spectrum>;
 
 [[nodiscard]] std::optional<Slice> BestFit(const Spectrum&, const uint64_t);
 
@@ -55,13 +128,29 @@ using Carriers = std::unordered_map<uint64_t, Spectrum>;
 
 [[nodiscard]] std::optional<Slice> LastFit(const Spectrum&, const uint64_t);
 
-[[nodiscard]] std::optional<Slice> RandomFit(const Spectrum&, const uint64_t);
+[[nodiscard]] std::optional<Slice> RandomFit(const Spectrum&, const uint64_t,
+                                             prng::Engine&);
 
 [[nodiscard]] std::optional<Slice> WorstFit(const Spectrum&, const uint64_t);
 
 using SpectrumAllocator =
     std::function<std::optional<Slice>(const Spectrum&, const uint64_t)>;
 
+class SpectrumAllocatorFactory final {
+ public:
+  [[nodiscard]] static bool Contains(const std::string&);
+
+  // The bitmap policy behind a deterministic allocator, if it has one.
+  [[nodiscard]] static std::optional<FitPolicy> Policy(const std::string&);
+
+  // Randomized policies draw from the given stream, which must outlive the
+  // returned allocator. Deterministic policies search the free-run list or the
+  // bitmap as chosen; random-fit always walks the list.
+  [[nodiscard]] static SpectrumAllocator CreateAllocator(const std::string&,
+                                                         prng::Engine&,
+                                                         const SpectrumSearch);
+};
+
 struct Fragmentation {
   virtual ~Fragmentation() = default;
 
@@ -70,6 +159,27 @@ struct Fragmentation {
 
 using FragmentationStrategy = std::shared_ptr<Fragmentation>;
 
+// A sum of per-link values that links update in place. It is kept in 32.32
+// fixed point, like Spectrum's entropy aggregate, so replacing a term leaves
+// no rounding behind whatever the update order. A saturated term (the
+// entropy of a full link) could never be subtracted back out of a floating
+// point sum, so those are counted apart and only folded in when the total is
+// read, where they saturate it just as summing them would.
+class LinkSum final {
+ public:
+  void replace(const double, const double) noexcept;
+
+  [[nodiscard]] double value(void) const noexcept;
+
+  void clear(void) noexcept;
+
+ private:
+  int64_t sum = 0;
+  uint64_t saturated = 0u;
+
+  void add(const double, const int64_t) noexcept;
+};
+
 struct AbsoluteFragmentation : public Fragmentation {
   [[nodiscard]] double operator()(const Spectrum&) const override;
 };
@@ -0,0 +1,65 @@
+#include "traffic.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace core {
+TrafficMatrix::TrafficMatrix(void) : vertices{0u} {}
+
+TrafficMatrix::TrafficMatrix(const uint64_t vertices)
+    : vertices{vertices}, _weights(vertices * vertices, 1.0) {
+  for (auto vertex = 0u; vertex < vertices; ++vertex) {
+    _weights[vertex * vertices + vertex] = 0.0;
+  }
+}
+
+std::optional<TrafficMatrix> TrafficMatrix::from(
+    const std::string& filename) noexcept {
+  std::ifstream file{filename};
+
+  if (!file.is_open()) {
+    return std::nullopt;
+  }
+
+  std::string line{};
+
+  std::getline(file, line);
+
+  TrafficMatrix matrix;
+
+  matrix.vertices = static_cast<uint64_t>(atoi(line.c_str()));
+
+  matrix._weights.assign(matrix.vertices * matrix.vertices, 0.0);
+
+  auto source{0u};
+
+  while (std::getline(file, line) && source < matrix.vertices) {
+    std::stringstream stream{line};
+
+    std::string buffer{};
+
+    for (auto destination = 0u; destination < matrix.vertices; ++destination) {
+      std::getline(stream, buffer, ' ');
+
+      const auto weight = source == destination ? 0.0 : atof(buffer.c_str());
+
+      matrix._weights[source * matrix.vertices + destination] = weight;
+    }
+
+    ++source;
+  }
+
+  return matrix;
+}
+
+uint64_t TrafficMatrix::size(void) const noexcept { return vertices; }
+
+double TrafficMatrix::at(const graph::Vertex source,
+                         const graph::Vertex destination) const {
+  return _weights.at(source * vertices + destination);
+}
+
+std::span<const double> TrafficMatrix::weights(void) const noexcept {
+  return _weights;
+}
+}  // namespace core
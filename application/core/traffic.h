@@ -0,0 +1,37 @@
+#pragma once
+
+#include <graph/vertex.h>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace core {
+// Relative demand between every ordered pair of vertices, stored row-major at
+// source * size + destination: the same layout as graph::RouteTable, so a pair
+// drawn from the matrix indexes its route directly. The diagonal is ignored.
+class TrafficMatrix final {
+ public:
+  TrafficMatrix(void);
+
+  // Uniform demand between every pair of distinct vertices.
+  TrafficMatrix(const uint64_t);
+
+  // Same layout as a topology file: the vertex count on the first line, then
+  // one row of space-separated weights per source.
+  [[nodiscard]] static std::optional<TrafficMatrix> from(
+      const std::string&) noexcept;
+
+  [[nodiscard]] uint64_t size(void) const noexcept;
+
+  [[nodiscard]] double at(const graph::Vertex, const graph::Vertex) const;
+
+  [[nodiscard]] std::span<const double> weights(void) const noexcept;
+
+ private:
+  uint64_t vertices;
+  std::vector<double> _weights;
+};
+}  // namespace core
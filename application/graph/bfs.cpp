@@ -1,6 +1,7 @@
 #include "bfs.h"
 
 #include <queue>
+#include <vector>
 
 namespace graph {
 BreadthFirstSearch::BreadthFirstSearch(const Graph& graph)
@@ -8,18 +9,12 @@ BreadthFirstSearch::BreadthFirstSearch(const Graph& graph)
 
 std::optional<Route> BreadthFirstSearch::compute(
     const Vertex source, const Vertex destination) const {
-  std::unordered_map<Vertex, bool> visited;
+  std::vector<bool> visited(graph.size(), false);
 
-  std::unordered_map<int, int> predecessors;
+  std::vector<EdgeId> predecessors(graph.size(), NullEdge);
 
   std::queue<Vertex> queue;
 
-  for (const auto& vertex : graph.get_vertices()) {
-    visited[vertex] = false;
-
-    predecessors[vertex] = -1;
-  }
-
   visited[source] = true;
 
   queue.push(source);
@@ -33,32 +28,26 @@ std::optional<Route> BreadthFirstSearch::compute(
       break;
     }
 
-    for (const auto& [adjacent, edges] : graph.at(vertex)) {
+    const auto adjacents = graph.adjacent(vertex);
+
+    const auto links = graph.links(vertex);
+
+    for (auto index = 0u; index < adjacents.size(); ++index) {
+      const auto adjacent = adjacents[index];
+
       if (visited[adjacent]) {
         continue;
       }
 
       visited[adjacent] = true;
 
-      predecessors[adjacent] = vertex;
+      predecessors[adjacent] = links[index];
 
       queue.push(adjacent);
     }
   }
 
-  std::unordered_set<Vertex> vertices;
-
-  Cost cost = Cost::min();
-
-  for (int vertex = destination; vertex != -1; vertex = predecessors[vertex]) {
-    vertices.insert(vertex);
-  }
-
-  if (*vertices.begin() != source) {
-    return std::nullopt;
-  }
-
-  return std::make_pair(vertices, cost);
+  return MakeRoute(graph, predecessors, source, destination);
 }
 
 }  // namespace graph
@@ -1,6 +1,7 @@
 #include "dfs.h"
 
 #include <stack>
+#include <vector>
 
 namespace graph {
 DepthFirstSearch::DepthFirstSearch(const Graph& graph)
@@ -8,18 +9,12 @@ DepthFirstSearch::DepthFirstSearch(const Graph& graph)
 
 std::optional<Route> DepthFirstSearch::compute(const Vertex source,
                                                const Vertex destination) const {
-  std::unordered_map<Vertex, bool> visited;
+  std::vector<bool> visited(graph.size(), false);
 
-  std::unordered_map<int, int> predecessors;
+  std::vector<EdgeId> predecessors(graph.size(), NullEdge);
 
   std::stack<Vertex> stack;
 
-  for (const auto& vertex : graph.get_vertices()) {
-    visited[vertex] = false;
-
-    predecessors[vertex] = -1;
-  }
-
   stack.push(source);
 
   while (!stack.empty()) {
@@ -37,30 +32,24 @@ std::optional<Route> DepthFirstSearch::compute(const Vertex source,
       break;
     }
 
-    for (const auto& [adjacent, edges] : graph.at(vertex)) {
+    const auto adjacents = graph.adjacent(vertex);
+
+    const auto links = graph.links(vertex);
+
+    for (auto index = 0u; index < adjacents.size(); ++index) {
+      const auto adjacent = adjacents[index];
+
       if (visited[adjacent]) {
         continue;
       }
 
-      predecessors[adjacent] = vertex;
+      predecessors[adjacent] = links[index];
 
       stack.push(adjacent);
     }
   }
 
-  std::unordered_set<Vertex> vertices;
-
-  Cost cost = Cost::min();
-
-  for (int vertex = destination; vertex != -1; vertex = predecessors[vertex]) {
-    vertices.insert(vertex);
-  }
-
-  if (*vertices.begin() != source) {
-    return std::nullopt;
-  }
-
-  return std::make_pair(vertices, cost);
+  return MakeRoute(graph, predecessors, source, destination);
 }
 
 }  // namespace graph
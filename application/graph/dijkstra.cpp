@@ -1,93 +1,125 @@
 #include "dijkstra.h"
 
-#include <queue>
+#include <bit>
+#include <limits>
 
 namespace graph {
-Dijkstra::Dijkstra(const Graph& graph) : RoutingStrategy{graph} {}
+using Key = RadixHeap::Key;
 
-std::optional<Route> Dijkstra::compute(const Vertex source,
-                                       const Vertex destination) const {
-  std::unordered_map<int, Cost> costs;
+static Key Pack(const Cost cost, const uint64_t hops, const Vertex vertex) {
+  return static_cast<Key>(std::bit_cast<uint64_t>(cost.value)) << 64u |
+         static_cast<Key>(hops) << 32u | static_cast<Key>(vertex);
+}
 
-  std::unordered_map<int, int> predecessors;
+Dijkstra::Dijkstra(const Graph& graph)
+    : RoutingStrategy{graph},
+      costs(graph.size()),
+      hops(graph.size()),
+      predecessors(graph.size()),
+      stamps(graph.size(), 0u),
+      excludedVertices(graph.size(), 0u),
+      excludedEdges(graph.edge_count(), 0u),
+      epoch{0u} {}
+
+// First visit of a vertex in the current query.
+void Dijkstra::Label(const Vertex vertex) const noexcept {
+  if (stamps[vertex] == epoch) {
+    return;
+  }
 
-  std::unordered_map<int, int> edge_hops;
+  stamps[vertex] = epoch;
 
-  // {cost, hops, vertex}
-  using path_t = std::tuple<Cost, int, int>;
+  costs[vertex] = Cost::max();
 
-  std::priority_queue<path_t, std::vector<path_t>, std::greater<>> queue;
+  hops[vertex] = std::numeric_limits<uint64_t>::max();
 
-  for (const auto& vertex : graph.get_vertices()) {
-    costs[vertex] = Cost::max();
+  predecessors[vertex] = NullEdge;
+}
 
-    predecessors[vertex] = -1;
+// Exclusions are stamped with the epoch of the query they apply to.
+void Dijkstra::exclude_vertex(const Vertex vertex) const noexcept {
+  excludedVertices[vertex] = epoch + 1u;
+}
 
-    edge_hops[vertex] = static_cast<long long int>(NullVertex);
-  }
+void Dijkstra::exclude_edge(const EdgeId edge) const noexcept {
+  excludedEdges[edge] = epoch + 1u;
+}
+
+std::optional<Route> Dijkstra::compute(const Vertex source,
+                                       const Vertex destination) const {
+  ++epoch;
+
+  queue.clear();
+
+  Label(source);
 
   costs[source] = Cost::min();
 
-  edge_hops[source] = 0u;
+  hops[source] = 0u;
 
-  queue.emplace(costs[source], edge_hops[source], source);
+  queue.push(Pack(costs[source], hops[source], source));
 
   while (!queue.empty()) {
-    const auto& [current_cost, hops, vertex] = queue.top();
+    const auto key = queue.pop();
+
+    const auto vertex = static_cast<Vertex>(key & 0xffffffffu);
+
+    const auto current_hops = static_cast<uint64_t>(key >> 32u & 0xffffffffu);
 
-    queue.pop();
+    const auto current_cost = Cost(costs[vertex]);
 
-    if (vertex == static_cast<int>(destination)) {
+    if (vertex == destination) {
       break;
     }
 
-    if (current_cost.value > costs[vertex].value) {
+    // Superseded by a cheaper or shorter label pushed later.
+    if (Pack(current_cost, current_hops, vertex) != key) {
       continue;
     }
 
-    if (current_cost.value == costs[vertex].value && hops > edge_hops[vertex]) {
-      continue;
-    }
+    const auto adjacents = graph.adjacent(vertex);
 
-    for (const auto& [adjacent, cost] : graph.at(vertex)) {
-      const auto new_cost = Cost(current_cost.value + cost.value);
+    const auto weights = graph.weights(vertex);
 
-      if (new_cost.value > costs[adjacent].value) {
+    const auto links = graph.links(vertex);
+
+    for (auto index = 0u; index < adjacents.size(); ++index) {
+      const auto adjacent = adjacents[index];
+
+      if (excludedVertices[adjacent] == epoch ||
+          excludedEdges[links[index]] == epoch) {
         continue;
       }
 
-      const auto new_hops{hops + 1};
+      Label(adjacent);
 
-      const auto less_hops{new_hops < edge_hops[adjacent]};
+      const auto new_cost = Cost(current_cost.value + weights[index].value);
 
-      if (new_cost.value == costs[adjacent].value && !less_hops) {
+      if (new_cost.value > costs[adjacent].value) {
         continue;
       }
 
-      costs[adjacent] = new_cost;
-
-      edge_hops[adjacent] = new_hops;
+      const auto new_hops{current_hops + 1u};
 
-      predecessors[adjacent] = vertex;
-
-      queue.emplace(new_cost, new_hops, adjacent);
-    }
-  }
+      if (new_cost.value == costs[adjacent].value &&
+          new_hops >= hops[adjacent]) {
+        continue;
+      }
 
-  std::unordered_set<Vertex> vertices;
+      costs[adjacent] = new_cost;
 
-  Cost cost = Cost::min();
+      hops[adjacent] = new_hops;
 
-  for (int vertex = destination; vertex != -1; vertex = predecessors[vertex]) {
-    vertices.insert(static_cast<Vertex>(vertex));
+      predecessors[adjacent] = links[index];
 
-    cost.value += costs[vertex].value;
+      queue.push(Pack(new_cost, new_hops, adjacent));
+    }
   }
 
-  if (*vertices.begin() != source) {
+  if (stamps[destination] != epoch) {
     return std::nullopt;
   }
 
-  return std::make_pair(vertices, cost);
+  return MakeRoute(graph, predecessors, source, destination);
 }
 }  // namespace graph
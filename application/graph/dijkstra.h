@@ -1,14 +1,44 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include "graph.h"
+#include "radix.h"
 #include "route.h"
 
 namespace graph {
+// Shortest path by cost, then by hops, stopping as soon as the destination is
+// settled. Labels live in flat per-vertex arrays kept across queries and
+// stamped with the query that wrote them, so a query only touches the vertices
+// it reaches. Candidates wait in a radix heap under a single key packing
+// (cost, hops, vertex): non-negative doubles order like their bit patterns,
+// so the cost needs no quantising and ties resolve as in a binary heap of
+// tuples. The reused state makes compute non-reentrant: keep one instance
+// per thread. Graphs are limited to 2^32 vertices.
 class Dijkstra : public RoutingStrategy {
  public:
   Dijkstra(const Graph&);
 
   [[nodiscard]] std::optional<Route> compute(const Vertex,
                                              const Vertex) const override;
+
+  // Bar a vertex or an edge from the next query only, as Yen's algorithm
+  // does to find routes that leave a known one at a given hop.
+  void exclude_vertex(const Vertex) const noexcept;
+
+  void exclude_edge(const EdgeId) const noexcept;
+
+ private:
+  mutable std::vector<Cost> costs;
+  mutable std::vector<uint64_t> hops;
+  mutable std::vector<EdgeId> predecessors;
+  mutable std::vector<uint64_t> stamps;
+  mutable std::vector<uint64_t> excludedVertices;
+  mutable std::vector<uint64_t> excludedEdges;
+  mutable uint64_t epoch;
+  mutable RadixHeap queue;
+
+  void Label(const Vertex) const noexcept;
 };
 }  // namespace graph
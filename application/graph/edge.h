@@ -1,10 +1,17 @@
 #pragma once
 
-#include <utility>
+#include <cstdint>
+#include <limits>
+#include <tuple>
 
 #include "cost.h"
 #include "vertex.h"
 
 namespace graph {
 using Edge = std::tuple<Vertex, Vertex, Cost>;
-}
+
+// Dense edge index in [0, Graph::edge_count()), assigned in insertion order.
+using EdgeId = uint64_t;
+
+constexpr EdgeId NullEdge = std::numeric_limits<uint64_t>::max();
+}  // namespace graph
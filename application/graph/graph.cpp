@@ -1,120 +1,54 @@
 #include "graph.h"
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/graph_traits.hpp>
+#include <algorithm>
 #include <format>
 #include <fstream>
 #include <ranges>
 #include <sstream>
+#include <stdexcept>
+#include <utility>
 
 namespace graph {
-struct Graph::Implementation {
-  typedef boost::property<boost::edge_weight_t, Cost> EdgeWeightProperty;
-  typedef boost::adjacency_list<boost::listS, boost::vecS, boost::directedS,
-                                boost::no_property, EdgeWeightProperty>
-      BoostGraph;
-
-  BoostGraph graph;
-
-  Implementation(void) = default;
-
-  Implementation(const uint64_t vertices) : graph(vertices) {}
-
-  Implementation(const BoostGraph& other_graph) : graph(other_graph) {}
-
-  uint64_t size() const { return boost::num_vertices(graph); }
-
-  Cost at(const Vertex source, const Vertex destination) const {
-    auto [edge, exists] = boost::edge(source, destination, graph);
-
-    return exists ? boost::get(boost::edge_weight, graph, edge) : Cost::min();
-  }
-
-  std::list<AdjacentVertex> at(const Vertex source) const {
-    std::list<AdjacentVertex> adjacents;
-
-    auto [begin, end] = boost::adjacent_vertices(source, graph);
-
-    for (auto iterator = begin; iterator != end; ++iterator) {
-      auto [edge, exists] = boost::edge(source, *iterator, graph);
-
-      if (!exists) {
-        continue;
-      }
-
-      Cost cost = boost::get(boost::edge_weight, graph, edge);
-
-      adjacents.emplace_back(*iterator, cost);
+Graph::Graph(void) : offsets(1u, 0u) {}
+
+Graph::Graph(const uint64_t vertices) : offsets(vertices + 1u, 0u) {}
+
+Graph::Graph(const uint64_t vertices, std::vector<Edge> list)
+    : edges{std::move(list)},
+      offsets(vertices + 1u, 0u),
+      targets(edges.size()),
+      costs(edges.size()),
+      ids(edges.size()) {
+  // Counting sort by source, stable so each vertex keeps its insertion order.
+  for (const auto& [source, destination, cost] : edges) {
+    if (source >= vertices || destination >= vertices) {
+      throw std::out_of_range(std::format(
+          "Edge from {} to {} outside {} vertices", source, destination,
+          vertices));
     }
 
-    return adjacents;
+    ++offsets[source + 1u];
   }
 
-  bool is_adjacent(const Vertex source, const Vertex destination) const {
-    auto [_, exists] = boost::edge(source, destination, graph);
-
-    return exists;
+  for (auto vertex = 0u; vertex < vertices; ++vertex) {
+    offsets[vertex + 1u] += offsets[vertex];
   }
 
-  std::set<Vertex> get_vertices() const {
-    std::set<Vertex> vertices;
-
-    auto [begin, end] = boost::vertices(graph);
-
-    for (auto iterator = begin; iterator != end; ++iterator) {
-      vertices.insert(static_cast<Vertex>(*iterator));
-    }
-
-    return vertices;
-  }
+  std::vector<uint64_t> next(offsets.begin(), offsets.end() - 1);
 
-  std::vector<Edge> get_edges() const {
-    std::vector<Edge> edges;
+  for (auto id = 0u; id < edges.size(); ++id) {
+    const auto& [source, destination, cost] = edges[id];
 
-    auto [begin, end] = boost::edges(graph);
+    const auto position = next[source]++;
 
-    for (auto iterator = begin; iterator != end; ++iterator) {
-      edges.push_back({static_cast<Vertex>(boost::source(*iterator, graph)),
-                       static_cast<Vertex>(boost::target(*iterator, graph)),
-                       boost::get(boost::edge_weight, graph, *iterator)});
-    }
+    targets[position] = destination;
 
-    return edges;
-  }
+    costs[position] = cost;
 
-  void add(const Vertex vertex) {
-    while (vertex >= boost::num_vertices(graph)) {
-      boost::add_vertex(graph);
-    }
+    ids[position] = id;
   }
-
-  void add(const Edge& edge) {
-    const auto& [source, destination, cost] = edge;
-
-    boost::add_edge(source, destination, EdgeWeightProperty(cost), graph);
-  }
-};
-
-Graph::Graph(void) : pImpl(std::make_unique<Implementation>()) {}
-
-Graph::Graph(const uint64_t vertices)
-    : pImpl(std::make_unique<Implementation>(vertices)) {}
-
-Graph::~Graph() = default;
-
-Graph::Graph(const Graph& other)
-    : pImpl(std::make_unique<Implementation>(other.pImpl->graph)) {}
-
-Graph& Graph::operator=(const Graph& other) {
-  if (this != &other) {
-    pImpl = std::make_unique<Implementation>(other.pImpl->graph);
-  }
-  return *this;
 }
 
-Graph::Graph(Graph&&) noexcept = default;
-Graph& Graph::operator=(Graph&&) noexcept = default;
-
 std::optional<Graph> Graph::from(const std::string& filename) noexcept {
   std::ifstream file{filename};
 
@@ -128,11 +62,11 @@ std::optional<Graph> Graph::from(const std::string& filename) noexcept {
 
   const auto size{static_cast<uint64_t>(atoi(line.c_str()))};
 
-  Graph graph{size};
+  std::vector<Edge> edges;
 
   auto source{0u};
 
-  while (std::getline(file, line)) {
+  while (std::getline(file, line) && source < size) {
     std::stringstream stream{line};
 
     std::string buffer{};
@@ -143,39 +77,65 @@ std::optional<Graph> Graph::from(const std::string& filename) noexcept {
       const auto cost = static_cast<double>(atof(buffer.c_str()));
 
       if (Cost::min().value != cost) {
-        graph.add({source, destination, cost});
+        edges.emplace_back(source, destination, cost);
       }
     }
 
     ++source;
   }
 
-  return graph;
+  return Graph(size, std::move(edges));
 }
 
-uint64_t Graph::size(void) const noexcept { return pImpl->size(); }
+uint64_t Graph::size(void) const noexcept { return offsets.size() - 1u; }
 
 Cost Graph::at(const Vertex source, const Vertex destination) const {
-  return pImpl->at(source, destination);
+  const auto adjacents = adjacent(source);
+
+  for (auto index = 0u; index < adjacents.size(); ++index) {
+    if (adjacents[index] == destination) {
+      return weights(source)[index];
+    }
+  }
+
+  return Cost::min();
 }
 
-std::list<AdjacentVertex> Graph::at(const Vertex vertex) const {
-  return pImpl->at(vertex);
+std::span<const Vertex> Graph::adjacent(const Vertex vertex) const noexcept {
+  return std::span(targets).subspan(offsets[vertex],
+                                    offsets[vertex + 1u] - offsets[vertex]);
 }
 
-bool Graph::is_adjacent(const Vertex source, const Vertex destination) const {
-  return pImpl->is_adjacent(source, destination);
+std::span<const Cost> Graph::weights(const Vertex vertex) const noexcept {
+  return std::span(costs).subspan(offsets[vertex],
+                                  offsets[vertex + 1u] - offsets[vertex]);
 }
 
-std::set<Vertex> Graph::get_vertices(void) const noexcept {
-  return pImpl->get_vertices();
+std::span<const EdgeId> Graph::links(const Vertex vertex) const noexcept {
+  return std::span(ids).subspan(offsets[vertex],
+                                offsets[vertex + 1u] - offsets[vertex]);
 }
 
-std::vector<Edge> Graph::get_edges(void) const noexcept {
-  return pImpl->get_edges();
+bool Graph::is_adjacent(const Vertex source, const Vertex destination) const {
+  const auto adjacents = adjacent(source);
+
+  return std::ranges::find(adjacents, destination) != adjacents.end();
 }
 
-void Graph::add(const Vertex vertex) { pImpl->add(vertex); }
+std::span<const Edge> Graph::get_edges(void) const noexcept { return edges; }
+
+uint64_t Graph::edge_count(void) const noexcept { return edges.size(); }
 
-void Graph::add(const Edge& edge) { pImpl->add(edge); }
+EdgeId Graph::edge_id(const Vertex source, const Vertex destination) const {
+  const auto adjacents = adjacent(source);
+
+  for (auto index = 0u; index < adjacents.size(); ++index) {
+    if (adjacents[index] == destination) {
+      return links(source)[index];
+    }
+  }
+
+  throw std::out_of_range(
+      std::format("No edge from {} to {}", source, destination));
+}
 }  // namespace graph
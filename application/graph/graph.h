@@ -1,12 +1,9 @@
 #pragma once
 
 #include <cstdint>
-#include <list>
-#include <memory>
 #include <optional>
-#include <set>
+#include <span>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "cost.h"
@@ -14,24 +11,20 @@
 #include "vertex.h"
 
 namespace graph {
+// Directed graph in compressed sparse row form, built once from its edge list
+// and immutable afterwards. The edges leaving vertex v sit at
+// [offsets[v], offsets[v + 1]) of three parallel arrays holding their targets,
+// weights and IDs, in insertion order, so a search walks contiguous memory.
+// Lookups by endpoints scan the source's edges and cost its out-degree.
 class Graph final {
-  struct Implementation;
-  std::unique_ptr<Implementation> pImpl;
-
  public:
   Graph(void);
 
   Graph(const uint64_t);
 
-  ~Graph();
-
-  Graph(const Graph& other);
-
-  Graph& operator=(const Graph& other);
-
-  Graph(Graph&&) noexcept;
-
-  Graph& operator=(Graph&&) noexcept;
+  // Edge IDs follow the order of the list; endpoints must be below the vertex
+  // count, or std::out_of_range is thrown.
+  Graph(const uint64_t, std::vector<Edge>);
 
   [[nodiscard]] static std::optional<Graph> from(const std::string&) noexcept;
 
@@ -39,16 +32,28 @@ class Graph final {
 
   [[nodiscard]] Cost at(const Vertex, const Vertex) const;
 
-  [[nodiscard]] std::list<AdjacentVertex> at(const Vertex) const;
+  // Targets, weights and IDs of the edges leaving a vertex, position by
+  // position.
+  [[nodiscard]] std::span<const Vertex> adjacent(const Vertex) const noexcept;
+
+  [[nodiscard]] std::span<const Cost> weights(const Vertex) const noexcept;
+
+  [[nodiscard]] std::span<const EdgeId> links(const Vertex) const noexcept;
 
   [[nodiscard]] bool is_adjacent(const Vertex, const Vertex) const;
 
-  [[nodiscard]] std::set<Vertex> get_vertices(void) const noexcept;
+  // Ordered by edge ID: the edge with ID i is at position i.
+  [[nodiscard]] std::span<const Edge> get_edges(void) const noexcept;
 
-  [[nodiscard]] std::vector<Edge> get_edges(void) const noexcept;
+  [[nodiscard]] uint64_t edge_count(void) const noexcept;
 
-  void add(const Vertex);
+  [[nodiscard]] EdgeId edge_id(const Vertex, const Vertex) const;
 
-  void add(const Edge&);
+ private:
+  std::vector<Edge> edges;
+  std::vector<uint64_t> offsets;
+  std::vector<Vertex> targets;
+  std::vector<Cost> costs;
+  std::vector<EdgeId> ids;
 };
 }  // namespace graph
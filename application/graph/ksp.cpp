@@ -1,55 +1,105 @@
 #include "ksp.h"
 
-#include <queue>
+#include <algorithm>
+#include <tuple>
+#include <utility>
 
 namespace graph {
-KShortestPath::KShortestPath(const Graph& graph) : graph{graph} {}
+KShortestPath::KShortestPath(const Graph& graph)
+    : graph{graph}, dijkstra{graph} {}
 
 std::vector<Route> KShortestPath::compute(const Vertex source,
-                                          Vertex destination,
+                                          const Vertex destination,
                                           const uint64_t k) const {
-  std::vector<Route> kShortestPaths{};
+  std::vector<Route> routes;
 
-  struct stub_t {
-    Vertex vertex;
-    Route path;
+  auto shortest = dijkstra.compute(source, destination);
 
-    stub_t(const Vertex vertex, const Route& path)
-        : vertex{vertex}, path{path} {}
+  if (k == 0u || !shortest.has_value()) {
+    return routes;
+  }
 
-    bool operator>(const stub_t& binding) const {
-      const auto& [vertices, cost] = path;
+  routes.push_back(std::move(shortest.value()));
 
-      const auto& [other_vertices, other_cost] = binding.path;
+  candidates.clear();
 
-      return cost.value > other_cost.value;
-    }
+  const auto edges = graph.get_edges();
+
+  const auto known = [&](const std::vector<EdgeId>& links) {
+    const auto same = [&](const Route& route) { return route.links == links; };
+
+    return std::ranges::any_of(routes, same) ||
+           std::ranges::any_of(candidates, same, &Candidate::route);
   };
 
-  std::priority_queue<stub_t, std::vector<stub_t>, std::greater<stub_t>> queue;
+  auto deviation = 0u;
 
-  queue.push(stub_t(source, {{source}, Cost::min()}));
+  while (routes.size() < k) {
+    const auto& last = routes.back();
 
-  while (!queue.empty() && kShortestPaths.size() != k) {
-    auto [vertex, path] = queue.top();
+    for (auto hop = deviation; hop + 1u < last.vertices.size(); ++hop) {
+      const auto root = std::span(last.links).first(hop);
 
-    queue.pop();
+      for (const auto& route : routes) {
+        if (route.links.size() > hop &&
+            std::ranges::equal(std::span(route.links).first(hop), root)) {
+          dijkstra.exclude_edge(route.links[hop]);
+        }
+      }
 
-    if (vertex == destination) {
-      kShortestPaths.push_back(path);
+      for (auto index = 0u; index < hop; ++index) {
+        dijkstra.exclude_vertex(last.vertices[index]);
+      }
 
-      continue;
-    }
+      const auto spur = dijkstra.compute(last.vertices[hop], destination);
+
+      if (!spur.has_value()) {
+        continue;
+      }
+
+      Route route{{last.vertices.begin(), last.vertices.begin() + hop},
+                  {root.begin(), root.end()},
+                  Cost::min()};
+
+      route.vertices.insert(route.vertices.end(), spur->vertices.begin(),
+                            spur->vertices.end());
 
-    for (const auto& [adjacent, cost] : graph.at(vertex)) {
-      auto& [vertices, path_cost] = path;
+      route.links.insert(route.links.end(), spur->links.begin(),
+                         spur->links.end());
 
-      vertices.insert(adjacent);
+      if (known(route.links)) {
+        continue;
+      }
 
-      queue.push(stub_t(adjacent, {vertices, path_cost.value + cost.value}));
+      // Summed from the source, as every search accumulates it.
+      for (const auto link : route.links) {
+        route.cost.value += std::get<2>(edges[link]).value;
+      }
+
+      candidates.push_back({std::move(route), hop});
+    }
+
+    if (candidates.empty()) {
+      break;
     }
+
+    const auto best = std::ranges::min_element(
+        candidates, [](const Candidate& lhs, const Candidate& rhs) {
+          return std::forward_as_tuple(lhs.route.cost.value,
+                                       lhs.route.links.size(),
+                                       lhs.route.links) <
+                 std::forward_as_tuple(rhs.route.cost.value,
+                                       rhs.route.links.size(),
+                                       rhs.route.links);
+        });
+
+    deviation = best->deviation;
+
+    routes.push_back(std::move(best->route));
+
+    candidates.erase(best);
   }
 
-  return kShortestPaths;
+  return routes;
 }
 }  // namespace graph
@@ -1,11 +1,21 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
+#include "dijkstra.h"
 #include "graph.h"
 #include "route.h"
 
 namespace graph {
+// K shortest loopless routes by Yen's algorithm (J. Yen, 1971) with Lawler's
+// refinement: a route found by leaving its parent at hop i is only ever
+// left again at hop i or later, since earlier deviations were already tried
+// from the parent. Each deviation is a Dijkstra query with the root's vertices
+// and the known routes' next edges excluded. Routes come cheapest first, ties
+// broken on hops and then on link IDs, and the first is the Dijkstra route.
+// The search state and candidate list are reused across queries, which makes
+// compute non-reentrant: keep one instance per thread.
 class KShortestPath {
  public:
   KShortestPath(const Graph&);
@@ -14,6 +24,14 @@ class KShortestPath {
                                            const uint64_t) const;
 
  private:
+  struct Candidate final {
+    Route route;
+    // Hop at which the route leaves the one it was derived from.
+    uint64_t deviation;
+  };
+
   const Graph& graph;
+  Dijkstra dijkstra;
+  mutable std::vector<Candidate> candidates;
 };
 }  // namespace graph
@@ -0,0 +1,77 @@
+#include "path.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+
+namespace graph {
+uint64_t Path::hops(void) const noexcept { return links.size(); }
+
+PathPool::PathPool(void) : offsets(1u, 0u) {}
+
+static uint64_t Hash(std::span<const EdgeId> links) {
+  const std::string_view bytes(reinterpret_cast<const char*>(links.data()),
+                               links.size_bytes());
+
+  return std::hash<std::string_view>{}(bytes);
+}
+
+PathId PathPool::intern(const Route& route) {
+  const auto key = Hash(route.links);
+
+  const auto [begin, end] = index.equal_range(key);
+
+  for (auto iterator = begin; iterator != end; ++iterator) {
+    if (std::ranges::equal((*this)[iterator->second].links, route.links)) {
+      return iterator->second;
+    }
+  }
+
+  if (size() >= NullPath) {
+    throw std::length_error("Path pool is out of 32-bit IDs");
+  }
+
+  const auto id = static_cast<PathId>(size());
+
+  links.insert(links.end(), route.links.begin(), route.links.end());
+
+  vertices.insert(vertices.end(), route.vertices.begin(),
+                  route.vertices.end());
+
+  offsets.push_back(links.size());
+
+  costs.push_back(route.cost);
+
+  index.emplace(key, id);
+
+  return id;
+}
+
+Path PathPool::operator[](const PathId id) const noexcept {
+  const auto begin = offsets[id];
+
+  const auto hops = offsets[id + 1u] - begin;
+
+  return Path{std::span(vertices).subspan(begin + id, hops + 1u),
+              std::span(links).subspan(begin, hops), costs[id]};
+}
+
+uint64_t PathPool::size(void) const noexcept { return costs.size(); }
+
+uint64_t PathPool::memory(void) const noexcept {
+  return offsets.capacity() * sizeof(uint64_t) +
+         links.capacity() * sizeof(EdgeId) +
+         vertices.capacity() * sizeof(Vertex) + costs.capacity() * sizeof(Cost);
+}
+
+void PathPool::shrink_to_fit(void) {
+  offsets.shrink_to_fit();
+
+  links.shrink_to_fit();
+
+  vertices.shrink_to_fit();
+
+  costs.shrink_to_fit();
+}
+}  // namespace graph
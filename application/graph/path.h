@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "cost.h"
+#include "edge.h"
+#include "route.h"
+#include "vertex.h"
+
+namespace graph {
+// Handle of a path interned in a PathPool.
+using PathId = uint32_t;
+
+constexpr PathId NullPath = std::numeric_limits<PathId>::max();
+
+// Read-only view of an interned path: its vertices in hop order, the ID of
+// the edge taken at each hop, and its cost, which on the bundled topologies
+// is its length in km. Valid for as long as the pool it came from.
+struct Path final {
+  std::span<const Vertex> vertices;
+  std::span<const EdgeId> links;
+  Cost cost;
+
+  [[nodiscard]] uint64_t hops(void) const noexcept;
+};
+
+// Append-only store of distinct paths, each named by a 32-bit ID. The link
+// IDs of every path share one contiguous buffer and their vertices another;
+// path i has offsets[i + 1] - offsets[i] links, starting at offsets[i] in the
+// first buffer and at offsets[i] + i in the second, since a path always has
+// one vertex more than it has links. Interning a path already held returns
+// its existing ID.
+class PathPool final {
+ public:
+  PathPool(void);
+
+  // Throws std::length_error once the IDs run out.
+  [[nodiscard]] PathId intern(const Route&);
+
+  [[nodiscard]] Path operator[](const PathId) const noexcept;
+
+  [[nodiscard]] uint64_t size(void) const noexcept;
+
+  // Bytes held by the path arrays, excluding the interning index.
+  [[nodiscard]] uint64_t memory(void) const noexcept;
+
+  void shrink_to_fit(void);
+
+ private:
+  std::vector<uint64_t> offsets;
+  std::vector<EdgeId> links;
+  std::vector<Vertex> vertices;
+  std::vector<Cost> costs;
+  std::unordered_multimap<uint64_t, PathId> index;
+};
+}  // namespace graph
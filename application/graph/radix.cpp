@@ -0,0 +1,79 @@
+#include "radix.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace graph {
+uint64_t RadixHeap::BucketOf(const Key key) const noexcept {
+  const auto difference = key ^ last;
+
+  const auto high = static_cast<uint64_t>(difference >> 64u);
+
+  return high != 0u ? 64u + std::bit_width(high)
+                    : std::bit_width(static_cast<uint64_t>(difference));
+}
+
+uint64_t RadixHeap::Lowest(void) const noexcept {
+  const auto low = static_cast<uint64_t>(occupied);
+
+  return 1u + (low != 0u ? std::countr_zero(low)
+                         : 64u + std::countr_zero(
+                                     static_cast<uint64_t>(occupied >> 64u)));
+}
+
+void RadixHeap::File(const Key key) {
+  const auto bucket = BucketOf(key);
+
+  buckets[bucket].push_back(key);
+
+  if (bucket != 0u) {
+    occupied |= static_cast<Key>(1u) << (bucket - 1u);
+  }
+}
+
+void RadixHeap::push(const Key key) {
+  File(key);
+
+  ++count;
+}
+
+RadixHeap::Key RadixHeap::pop(void) {
+  if (buckets.front().empty()) {
+    auto& bucket = buckets[Lowest()];
+
+    occupied &= occupied - 1u;
+
+    // Every key in the bucket shares the bits above its number with the new
+    // minimum, so each one lands in a strictly lower bucket.
+    last = *std::ranges::min_element(bucket);
+
+    for (const auto key : bucket) {
+      File(key);
+    }
+
+    bucket.clear();
+  }
+
+  const auto key = buckets.front().back();
+
+  buckets.front().pop_back();
+
+  --count;
+
+  return key;
+}
+
+bool RadixHeap::empty(void) const noexcept { return count == 0u; }
+
+void RadixHeap::clear(void) noexcept {
+  buckets.front().clear();
+
+  for (; occupied != 0u; occupied &= occupied - 1u) {
+    buckets[Lowest()].clear();
+  }
+
+  last = 0u;
+
+  count = 0u;
+}
+}  // namespace graph
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace graph {
+// Monotone priority queue (R. Ahuja, K. Mehlhorn, J. Orlin and R. Tarjan,
+// 1990) over 128-bit keys. A key is filed under the highest bit in which it
+// differs from the last key popped, so it drops at most 128 buckets before
+// leaving, and pop only ever scans the lowest non-empty bucket. Keys pushed
+// must not be below the last key popped, which holds for Dijkstra labels.
+// Buckets keep their storage across clear, so a warm heap does not allocate.
+class RadixHeap final {
+ public:
+  __extension__ typedef unsigned __int128 Key;
+
+  void push(const Key);
+
+  // Removes and returns the smallest key; the heap must not be empty.
+  Key pop(void);
+
+  [[nodiscard]] bool empty(void) const noexcept;
+
+  void clear(void) noexcept;
+
+ private:
+  std::array<std::vector<Key>, 129u> buckets;
+  Key last = 0u;
+  uint64_t count = 0u;
+
+  // Bit i - 1 is set while bucket i holds keys, so the next bucket to split
+  // is found with a bit scan rather than by probing empty buckets.
+  Key occupied = 0u;
+
+  [[nodiscard]] uint64_t BucketOf(const Key) const noexcept;
+
+  [[nodiscard]] uint64_t Lowest(void) const noexcept;
+
+  void File(const Key);
+};
+}  // namespace graph
@@ -1,33 +1,43 @@
 #include "route.h"
 
-#include <prng/prng.h>
-
-#include "dijkstra.h"
+#include <algorithm>
 
 namespace graph {
-RoutingStrategy::RoutingStrategy(const Graph& graph) : graph{graph} {}
+std::optional<Route> MakeRoute(const Graph& graph,
+                               std::span<const EdgeId> predecessors,
+                               const Vertex source, const Vertex destination) {
+  const auto edges = graph.get_edges();
 
-RandomRouting::RandomRouting(const Graph& graph) : RoutingStrategy{graph} {}
+  Route route{{}, {}, Cost::min()};
 
-std::optional<Route> RandomRouting::compute(const Vertex, const Vertex) const {
-  static Dijkstra dijkstra(graph);
+  for (auto vertex = destination; vertex != source;) {
+    const auto link = predecessors[vertex];
 
-  while (true) {
-    auto source = static_cast<Vertex>(
-        prng::PseudoRandomNumberGenerator::Instance()->Next("routing"));
+    if (link == NullEdge) {
+      return std::nullopt;
+    }
 
-    auto destination = static_cast<Vertex>(
-        prng::PseudoRandomNumberGenerator::Instance()->Next("routing"));
+    route.links.push_back(link);
 
-    if (source == destination) {
-      continue;
-    }
+    vertex = std::get<0>(edges[link]);
+  }
 
-    const auto route = dijkstra.compute(source, destination);
+  std::ranges::reverse(route.links);
 
-    if (route.has_value()) {
-      return route;
-    }
+  route.vertices.reserve(route.links.size() + 1u);
+
+  route.vertices.push_back(source);
+
+  for (const auto link : route.links) {
+    const auto& [from, to, cost] = edges[link];
+
+    route.vertices.push_back(to);
+
+    route.cost.value += cost.value;
   }
+
+  return route;
 }
+
+RoutingStrategy::RoutingStrategy(const Graph& graph) : graph{graph} {}
 }  // namespace graph
@@ -1,12 +1,27 @@
 #pragma once
 
 #include <optional>
-#include <unordered_set>
+#include <span>
+#include <vector>
 
 #include "graph.h"
 
 namespace graph {
-using Route = std::pair<std::unordered_set<Vertex>, Cost>;
+// Vertices in hop order from source to destination, the ID of the edge taken
+// at each hop, and the path cost. Consumers walk links and never look edges
+// up by their endpoints.
+struct Route final {
+  std::vector<Vertex> vertices;
+  std::vector<EdgeId> links;
+  Cost cost;
+};
+
+// Follows the edge a search took into each vertex, indexed by vertex, back
+// from the destination; there is no route when the walk misses the source.
+// The cost is summed from the source, in the order a search accumulates it.
+[[nodiscard]] std::optional<Route> MakeRoute(const Graph&,
+                                             std::span<const EdgeId>,
+                                             const Vertex, const Vertex);
 
 class RoutingStrategy {
  public:
@@ -20,12 +35,4 @@ class RoutingStrategy {
  protected:
   const Graph& graph;
 };
-
-class RandomRouting : public RoutingStrategy {
- public:
-  RandomRouting(const Graph&);
-
-  [[nodiscard]] std::optional<Route> compute(const Vertex,
-                                             const Vertex) const override;
-};
 }  // namespace graph
@@ -0,0 +1,167 @@
+#include "table.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <format>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+#include "ksp.h"
+
+namespace graph {
+// Vertex count of a graph whose pair indices fit in 32 bits.
+static uint64_t Vertices(const Graph& graph) {
+  const auto vertices = graph.size();
+
+  if (vertices > 0u &&
+      vertices > std::numeric_limits<uint32_t>::max() / vertices) {
+    throw std::length_error(std::format(
+        "{} vertices have too many pairs for 32-bit indices", vertices));
+  }
+
+  return vertices;
+}
+
+RouteTable::RouteTable(void) : vertices{0u}, k{1u} {}
+
+RouteTable::RouteTable(const Graph& graph, const RoutingStrategy& strategy)
+    : vertices{Vertices(graph)}, k{1u} {
+  slots.reserve(vertices * vertices);
+
+  for (auto source = 0u; source < vertices; ++source) {
+    for (auto destination = 0u; destination < vertices; ++destination) {
+      std::vector<Route> routes;
+
+      if (source != destination) {
+        auto route = strategy.compute(source, destination);
+
+        if (route.has_value()) {
+          routes.push_back(std::move(route.value()));
+        }
+      }
+
+      Append(routes);
+    }
+  }
+
+  pool.shrink_to_fit();
+}
+
+RouteTable::RouteTable(const Graph& graph, const uint64_t paths,
+                       const uint64_t threads)
+    : vertices{Vertices(graph)}, k{std::max<uint64_t>(1u, paths)} {
+  // Routes by source, then destination, in rank order. Workers claim the next
+  // source until none is left, each with its own search state, and the
+  // results are packed in pair order afterwards. A single route per pair is
+  // the Dijkstra route KShortestPath starts from, so its engine is the only
+  // one a worker needs.
+  std::vector<std::vector<std::vector<Route>>> results(vertices);
+
+  std::atomic<uint64_t> next{0u};
+
+  // The first failure stops every worker from claiming more sources and is
+  // rethrown here once they have all joined, since an exception escaping a
+  // thread would terminate the program.
+  std::mutex mutex;
+
+  std::exception_ptr failure;
+
+  const auto worker = [&]() {
+    try {
+      const KShortestPath ksp(graph);
+
+      for (auto source = next++; source < vertices; source = next++) {
+        auto& row = results[source];
+
+        row.resize(vertices);
+
+        for (auto destination = 0u; destination < vertices; ++destination) {
+          if (source != destination) {
+            row[destination] = ksp.compute(source, destination, k);
+          }
+        }
+      }
+    } catch (...) {
+      const std::lock_guard<std::mutex> lock(mutex);
+
+      if (!failure) {
+        failure = std::current_exception();
+      }
+
+      next = vertices;
+    }
+  };
+
+  {
+    std::vector<std::jthread> workers;
+
+    for (auto index = 1u; index < std::min(threads, vertices); ++index) {
+      workers.emplace_back(worker);
+    }
+
+    worker();
+  }
+
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+
+  slots.reserve(vertices * vertices * k);
+
+  for (auto& row : results) {
+    for (const auto& routes : row) {
+      Append(routes);
+    }
+
+    row = {};
+  }
+
+  pool.shrink_to_fit();
+}
+
+void RouteTable::Append(const std::vector<Route>& routes) {
+  for (auto rank = 0u; rank < k; ++rank) {
+    slots.push_back(rank < routes.size() ? pool.intern(routes[rank])
+                                         : NullPath);
+  }
+}
+
+uint64_t RouteTable::size(void) const noexcept { return vertices; }
+
+uint64_t RouteTable::paths(void) const noexcept { return k; }
+
+uint64_t RouteTable::index(const Vertex source,
+                           const Vertex destination) const noexcept {
+  return source * vertices + destination;
+}
+
+uint64_t RouteTable::count(const uint64_t pair) const noexcept {
+  auto rank = 0u;
+
+  while (rank < k && route(pair, rank) != NullPath) {
+    ++rank;
+  }
+
+  return rank;
+}
+
+PathId RouteTable::at(const Vertex source, const Vertex destination,
+                      const uint64_t rank) const noexcept {
+  return route(index(source, destination), rank);
+}
+
+PathId RouteTable::route(const uint64_t pair,
+                         const uint64_t rank) const noexcept {
+  return slots[pair * k + rank];
+}
+
+Path RouteTable::path(const PathId id) const noexcept { return pool[id]; }
+
+uint64_t RouteTable::memory(void) const noexcept {
+  return slots.capacity() * sizeof(PathId) + pool.memory();
+}
+}  // namespace graph
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "graph.h"
+#include "path.h"
+#include "route.h"
+
+namespace graph {
+// Routes between every ordered pair of vertices, computed once up front. Up
+// to k routes per pair are kept cheapest first, and the route of rank j for
+// pair p = source * size + destination sits in slot p * k + j as the ID of a
+// path in the table's pool, so a slot is 32 bits and every path's links lie
+// contiguously in one buffer. Slots without a route, including every
+// source == destination pair, hold NullPath. Requests keep pair indices in 32
+// bits, so building a table for a graph with more pairs throws
+// std::length_error.
+class RouteTable final {
+ public:
+  RouteTable(void);
+
+  // One route per pair from any strategy, computed in turn.
+  RouteTable(const Graph&, const RoutingStrategy&);
+
+  // The given number of shortest loopless routes per pair, with sources
+  // shared out among the given number of threads. The table is the same
+  // for any thread count, and a worker's exception is rethrown on the
+  // calling thread.
+  RouteTable(const Graph&, const uint64_t, const uint64_t);
+
+  [[nodiscard]] uint64_t size(void) const noexcept;
+
+  // Routes kept per pair at most.
+  [[nodiscard]] uint64_t paths(void) const noexcept;
+
+  [[nodiscard]] uint64_t index(const Vertex, const Vertex) const noexcept;
+
+  // Routes held for a pair, by pair index.
+  [[nodiscard]] uint64_t count(const uint64_t) const noexcept;
+
+  [[nodiscard]] PathId at(const Vertex, const Vertex,
+                          const uint64_t = 0u) const noexcept;
+
+  // A pair's route of the given rank, by pair index.
+  [[nodiscard]] PathId route(const uint64_t, const uint64_t) const noexcept;
+
+  [[nodiscard]] Path path(const PathId) const noexcept;
+
+  // Bytes held by the slots and the path pool.
+  [[nodiscard]] uint64_t memory(void) const noexcept;
+
+ private:
+  uint64_t vertices;
+  uint64_t k;
+  std::vector<PathId> slots;
+  PathPool pool;
+
+  void Append(const std::vector<Route>&);
+};
+}  // namespace graph
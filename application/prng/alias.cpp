@@ -0,0 +1,81 @@
+#include "alias.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace prng {
+Alias::Alias(const std::vector<double>& weights) : _columns(weights.size()) {
+  if (weights.empty() ||
+      weights.size() > std::numeric_limits<uint32_t>::max()) {
+    throw std::invalid_argument(
+        std::format("Alias table needs 1 to 2^32 - 1 outcomes, got {}",
+                    weights.size()));
+  }
+
+  const auto invalid = [](const double weight) {
+    return !std::isfinite(weight) || weight < 0.0;
+  };
+
+  if (std::any_of(weights.begin(), weights.end(), invalid)) {
+    throw std::invalid_argument("Alias table weights must be finite and >= 0");
+  }
+
+  const auto sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+
+  if (!(sum > 0.0)) {
+    throw std::invalid_argument("Alias table weights must not all be zero");
+  }
+
+  const auto size = weights.size();
+
+  std::vector<double> scaled(size);
+
+  std::vector<uint32_t> small;
+
+  std::vector<uint32_t> large;
+
+  for (auto index = 0u; index < size; ++index) {
+    scaled[index] = weights[index] * static_cast<double>(size) / sum;
+
+    (scaled[index] < 1.0 ? small : large).push_back(index);
+  }
+
+  constexpr auto Scale = 0x1.0p32;
+
+  const auto threshold = [&](const double probability) {
+    return static_cast<uint32_t>(
+        std::min(probability * Scale, Scale - 1.0));
+  };
+
+  while (!small.empty() && !large.empty()) {
+    const auto less = small.back();
+
+    const auto more = large.back();
+
+    small.pop_back();
+
+    _columns[less] = {threshold(scaled[less]), more};
+
+    scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+
+    if (scaled[more] < 1.0) {
+      large.pop_back();
+
+      small.push_back(more);
+    }
+  }
+
+  // Whatever is left is within rounding of a full column and keeps itself.
+  for (const auto& leftover : {small, large}) {
+    for (const auto index : leftover) {
+      _columns[index] = {std::numeric_limits<uint32_t>::max(), index};
+    }
+  }
+}
+
+uint64_t Alias::size(void) const noexcept { return _columns.size(); }
+}  // namespace prng
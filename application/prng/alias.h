@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "distribution.h"
+
+namespace prng {
+// Walker's alias method, built with Vose's algorithm. The outcomes are spread
+// over n equiprobable columns; a column yields its own outcome below its
+// threshold and its alias above it. A draw costs one engine word, one
+// multiply and one comparison, whatever the number of outcomes.
+class Alias final : public Distribution {
+  struct Column final {
+    uint32_t threshold;
+    uint32_t alias;
+  };
+
+  std::vector<Column> _columns;
+
+ public:
+  template <typename Iterator>
+  Alias(Iterator begin, Iterator end) : Alias(std::vector<double>(begin, end)) {}
+
+  Alias(const std::vector<double>&);
+
+  // Outcome index: the high half of the word picks the column, the low half
+  // decides between the column and its alias.
+  [[nodiscard]] uint64_t Sample(Engine& engine) const {
+    const auto bits = engine();
+
+    const auto column = ((bits >> 32u) * _columns.size()) >> 32u;
+
+    const auto& [threshold, alias] = _columns[column];
+
+    return static_cast<uint32_t>(bits) < threshold ? column : alias;
+  }
+
+  [[nodiscard]] double Next(Engine& engine) override {
+    return static_cast<double>(Sample(engine));
+  }
+
+  [[nodiscard]] uint64_t size(void) const noexcept;
+};
+}  // namespace prng
@@ -0,0 +1,97 @@
+#include "block.h"
+
+#include <array>
+#include <bit>
+
+namespace prng {
+// Top 53 bits of a word as a double in [0, 1).
+static inline double Canonical(const uint64_t bits) {
+  return static_cast<double>(bits >> 11u) * 0x1.0p-53;
+}
+
+// Natural logarithm of a positive normal double using only integer and
+// floating-point arithmetic, so the transform loops vectorize without relying
+// on a vector math library. x = 2^k * z with z in [sqrt(1/2), sqrt(2)), and
+// log(z) = 2 atanh(s), s = (z - 1) / (z + 1), whose odd series converges to
+// double precision within eleven terms because |s| < 0.172.
+static inline double Log(const double x) {
+  constexpr uint64_t Offset = 0x3FE6A09E667F3BCDu;
+
+  constexpr double Ln2 = 0x1.62E42FEFA39EFp-1;
+
+  constexpr std::array<double, 10> Coefficients{
+      1.0 / 3.0,  1.0 / 5.0,  1.0 / 7.0,  1.0 / 9.0,  1.0 / 11.0,
+      1.0 / 13.0, 1.0 / 15.0, 1.0 / 17.0, 1.0 / 19.0, 1.0 / 21.0,
+  };
+
+  const auto bits = std::bit_cast<uint64_t>(x);
+
+  const auto shifted = bits - Offset;
+
+  const auto k = static_cast<double>(static_cast<int64_t>(shifted) >> 52);
+
+  const auto z = std::bit_cast<double>(bits - (shifted & (0xFFFull << 52u)));
+
+  const auto s = (z - 1.0) / (z + 1.0);
+
+  const auto s2 = s * s;
+
+  auto series = Coefficients.back();
+
+  for (auto index = Coefficients.size() - 1u; index > 0u; --index) {
+    series = series * s2 + Coefficients[index - 1u];
+  }
+
+  return k * Ln2 + 2.0 * s * (1.0 + s2 * series);
+}
+
+Block::Block(void) : bits(Size), buffer(Size), index{Size} {}
+
+void Block::Reset(void) { index = Size; }
+
+void Block::Refill(Engine& engine) {
+  engine.Fill(bits);
+
+  Transform(bits, buffer);
+
+  index = 0u;
+}
+
+UniformBlock::UniformBlock(const double min, const double max)
+    : _min{min}, _max{max} {}
+
+void UniformBlock::Transform(std::span<const uint64_t> bits,
+                             std::span<double> buffer) const {
+  const auto range = _max - _min;
+
+  for (auto index = 0u; index < bits.size(); ++index) {
+    buffer[index] = _min + range * Canonical(bits[index]);
+  }
+}
+
+ExponentialBlock::ExponentialBlock(const double rate) : _rate{rate} {}
+
+void ExponentialBlock::Transform(std::span<const uint64_t> bits,
+                                 std::span<double> buffer) const {
+  const auto scale = -1.0 / _rate;
+
+  for (auto index = 0u; index < bits.size(); ++index) {
+    buffer[index] = scale * Log(1.0 - Canonical(bits[index]));
+  }
+}
+
+void DiscreteBlock::Transform(std::span<const uint64_t> bits,
+                              std::span<double> buffer) const {
+  for (auto index = 0u; index < bits.size(); ++index) {
+    const auto u = Canonical(bits[index]);
+
+    auto outcome = 0.0;
+
+    for (const auto threshold : _cumulative) {
+      outcome += u >= threshold ? 1.0 : 0.0;
+    }
+
+    buffer[index] = outcome;
+  }
+}
+}  // namespace prng
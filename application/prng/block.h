@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "distribution.h"
+
+namespace prng {
+// Buffered distribution: variates are produced Size at a time, first draining
+// the stream into a bit buffer and then mapping the whole buffer through a
+// branch-free transform that the compiler can vectorize. Next only pops.
+class Block : public Distribution {
+ public:
+  static constexpr uint64_t Size = 4096u;
+
+  Block(void);
+
+  [[nodiscard]] double Next(Engine& engine) final {
+    if (index == Size) {
+      Refill(engine);
+    }
+
+    return buffer[index++];
+  }
+
+  void Reset(void) final;
+
+ protected:
+  virtual void Transform(std::span<const uint64_t>, std::span<double>) const = 0;
+
+ private:
+  std::vector<uint64_t> bits;
+  std::vector<double> buffer;
+  uint64_t index;
+
+  void Refill(Engine&);
+};
+
+class UniformBlock final : public Block {
+  double _min;
+  double _max;
+
+ public:
+  UniformBlock(const double, const double);
+
+ protected:
+  void Transform(std::span<const uint64_t>, std::span<double>) const override;
+};
+
+class ExponentialBlock final : public Block {
+  double _rate;
+
+ public:
+  ExponentialBlock(const double);
+
+ protected:
+  void Transform(std::span<const uint64_t>, std::span<double>) const override;
+};
+
+class DiscreteBlock final : public Block {
+  std::vector<double> _cumulative;
+
+ public:
+  template <typename Iterator>
+  DiscreteBlock(Iterator begin, Iterator end) {
+    auto sum = 0.0;
+
+    for (auto iterator = begin; iterator != end; ++iterator) {
+      sum += *iterator;
+
+      _cumulative.push_back(sum);
+    }
+
+    if (!_cumulative.empty()) {
+      _cumulative.pop_back();
+    }
+
+    for (auto& value : _cumulative) {
+      value /= sum;
+    }
+  }
+
+ protected:
+  void Transform(std::span<const uint64_t>, std::span<double>) const override;
+};
+}  // namespace prng
@@ -1,7 +1,7 @@
 #include "discrete.h"
 
 namespace prng {
-double Discrete::Next(std::mt19937& generator) {
+double Discrete::Next(Engine& generator) {
   return static_cast<double>(_distribution(generator));
 }
 }  // namespace prng
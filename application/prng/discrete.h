@@ -12,7 +12,7 @@ class Discrete final : public Distribution {
   template <typename Iterator>
   Discrete(Iterator begin, Iterator end) : _distribution{begin, end} {}
 
-  [[nodiscard]] double Next(std::mt19937&) override;
+  [[nodiscard]] double Next(Engine&) override;
 };
 
 }  // namespace prng
@@ -2,4 +2,6 @@
 
 namespace prng {
 Distribution::~Distribution() {}
+
+void Distribution::Reset(void) {}
 }  // namespace prng
@@ -1,12 +1,15 @@
 #pragma once
 
-#include <random>
+#include "engine.h"
 
 namespace prng {
 class Distribution {
  public:
   virtual ~Distribution();
 
-  [[nodiscard]] virtual double Next(std::mt19937&) = 0;
+  [[nodiscard]] virtual double Next(Engine&) = 0;
+
+  // Drops any state carried over from the previous seed.
+  virtual void Reset(void);
 };
 }  // namespace prng
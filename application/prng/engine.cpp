@@ -0,0 +1,54 @@
+#include "engine.h"
+
+namespace prng {
+// Full 64 x 64 bit product; __extension__ keeps -pedantic quiet about it.
+__extension__ typedef unsigned __int128 Product;
+
+static std::variant<std::mt19937_64, Philox, Xoshiro> Make(
+    const Engine::Type type, const uint64_t seed, const uint64_t stream) {
+  if (type == Engine::Type::Philox) {
+    return Philox(seed, stream);
+  }
+
+  if (type == Engine::Type::Xoshiro) {
+    return Xoshiro(seed, stream);
+  }
+
+  std::seed_seq sequence{
+      static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32u),
+      static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32u)};
+
+  return std::mt19937_64(sequence);
+}
+
+Engine::Engine(const Type type, const uint64_t seed, const uint64_t stream)
+    : generator{Make(type, seed, stream)} {}
+
+Engine::result_type Engine::operator()(void) {
+  return std::visit([](auto& generator) { return generator(); }, generator);
+}
+
+uint64_t Engine::Below(const uint64_t bound) {
+  auto product = static_cast<Product>((*this)()) * bound;
+
+  if (static_cast<uint64_t>(product) < bound) {
+    const auto threshold = -bound % bound;
+
+    while (static_cast<uint64_t>(product) < threshold) {
+      product = static_cast<Product>((*this)()) * bound;
+    }
+  }
+
+  return static_cast<uint64_t>(product >> 64u);
+}
+
+void Engine::Fill(std::span<result_type> buffer) {
+  std::visit(
+      [&](auto& generator) {
+        for (auto& value : buffer) {
+          value = generator();
+        }
+      },
+      generator);
+}
+}  // namespace prng
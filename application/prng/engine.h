@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <variant>
+
+#include "philox.h"
+#include "xoshiro.h"
+
+namespace prng {
+// Uniform bit source behind every distribution. A (seed, stream) pair fully
+// determines the sequence, so substreams can be derived independently.
+class Engine final {
+ public:
+  enum class Type {
+    MersenneTwister,
+    Philox,
+    Xoshiro,
+  };
+
+  using result_type = uint64_t;
+
+  Engine(const Type, const uint64_t, const uint64_t);
+
+  [[nodiscard]] static constexpr result_type min(void) noexcept {
+    return std::numeric_limits<result_type>::min();
+  }
+
+  [[nodiscard]] static constexpr result_type max(void) noexcept {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()(void);
+
+  // Unbiased integer in [0, bound) by multiply-shift with rejection, which
+  // almost always takes a single draw and, unlike
+  // std::uniform_int_distribution, yields the same sequence on every standard
+  // library. bound must be positive.
+  [[nodiscard]] uint64_t Below(const uint64_t);
+
+  // Bulk draw: dispatches on the engine once and then runs a tight loop.
+  void Fill(std::span<result_type>);
+
+ private:
+  std::variant<std::mt19937_64, Philox, Xoshiro> generator;
+};
+}  // namespace prng
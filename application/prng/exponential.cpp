@@ -3,7 +3,7 @@
 namespace prng {
 Exponential::Exponential(const double mean) : _distribution{mean} {}
 
-double Exponential::Next(std::mt19937& generator) {
+double Exponential::Next(Engine& generator) {
   return _distribution(generator);
 }
 
@@ -11,6 +11,6 @@ class Exponential final : public Distribution {
  public:
   Exponential(const double);
 
-  [[nodiscard]] double Next(std::mt19937&) override;
+  [[nodiscard]] double Next(Engine&) override;
 };
 }  // namespace prng
@@ -4,8 +4,10 @@ namespace prng {
 Normal::Normal(const double mean, const double deviation)
     : _distribution{mean, deviation} {}
 
-double Normal::Next(std::mt19937& generator) {
+double Normal::Next(Engine& generator) {
   return _distribution(generator);
 }
 
+void Normal::Reset(void) { _distribution.reset(); }
+
 }  // namespace prng
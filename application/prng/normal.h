@@ -11,7 +11,9 @@ class Normal final : public Distribution {
  public:
   Normal(const double, const double);
 
-  [[nodiscard]] double Next(std::mt19937&) override;
+  [[nodiscard]] double Next(Engine&) override;
+
+  void Reset(void) override;
 };
 
 }  // namespace prng
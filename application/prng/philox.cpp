@@ -0,0 +1,60 @@
+#include "philox.h"
+
+namespace prng {
+constexpr uint32_t M0 = 0xD2511F53u;
+
+constexpr uint32_t M1 = 0xCD9E8D57u;
+
+constexpr uint32_t W0 = 0x9E3779B9u;
+
+constexpr uint32_t W1 = 0xBB67AE85u;
+
+constexpr uint8_t Rounds = 10u;
+
+Philox::Philox(const uint64_t seed, const uint64_t stream)
+    : key{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32u)},
+      counter{0u},
+      stream{stream},
+      buffer{0u, 0u},
+      index{static_cast<uint8_t>(buffer.size())} {}
+
+Philox::result_type Philox::operator()(void) {
+  if (index == buffer.size()) {
+    Refill();
+  }
+
+  return buffer[index++];
+}
+
+void Philox::Refill(void) {
+  std::array<uint32_t, 4> block{
+      static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32u),
+      static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32u)};
+
+  auto [k0, k1] = key;
+
+  for (auto round = 0u; round < Rounds; ++round) {
+    const auto p0 = static_cast<uint64_t>(M0) * block[0];
+
+    const auto p1 = static_cast<uint64_t>(M1) * block[2];
+
+    block = {static_cast<uint32_t>(p1 >> 32u) ^ block[1] ^ k0,
+             static_cast<uint32_t>(p1),
+             static_cast<uint32_t>(p0 >> 32u) ^ block[3] ^ k1,
+             static_cast<uint32_t>(p0)};
+
+    k0 += W0;
+
+    k1 += W1;
+  }
+
+  buffer = {static_cast<uint64_t>(block[0]) |
+                static_cast<uint64_t>(block[1]) << 32u,
+            static_cast<uint64_t>(block[2]) |
+                static_cast<uint64_t>(block[3]) << 32u};
+
+  ++counter;
+
+  index = 0u;
+}
+}  // namespace prng
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace prng {
+// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2,
+// 3", SC'11). The output is a bijection of a 128-bit counter under a 64-bit
+// key, so every (seed, stream) pair names an independent sequence that can
+// be created anywhere without coordinating with other streams.
+class Philox final {
+ public:
+  using result_type = uint64_t;
+
+  Philox(const uint64_t, const uint64_t);
+
+  [[nodiscard]] static constexpr result_type min(void) noexcept {
+    return std::numeric_limits<result_type>::min();
+  }
+
+  [[nodiscard]] static constexpr result_type max(void) noexcept {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()(void);
+
+ private:
+  std::array<uint32_t, 2> key;
+  uint64_t counter;
+  uint64_t stream;
+  std::array<uint64_t, 2> buffer;
+  uint8_t index;
+
+  void Refill(void);
+};
+}  // namespace prng
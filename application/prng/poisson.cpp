@@ -3,7 +3,7 @@
 namespace prng {
 Poisson::Poisson(const double mean) : _distribution{mean} {}
 
-double Poisson::Next(std::mt19937& generator) {
+double Poisson::Next(Engine& generator) {
   return static_cast<double>(_distribution(generator));
 }
 
@@ -11,6 +11,6 @@ class Poisson final : public Distribution {
  public:
   Poisson(const double);
 
-  [[nodiscard]] double Next(std::mt19937&) override;
+  [[nodiscard]] double Next(Engine&) override;
 };
 }  // namespace prng
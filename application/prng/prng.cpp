@@ -1,53 +1,84 @@
 #include "prng.h"
 
-#include "exponential.h"
-#include "normal.h"
-#include "poisson.h"
-#include "uniform.h"
-
 namespace prng {
-std::shared_ptr<PseudoRandomNumberGenerator>
-PseudoRandomNumberGenerator::Instance(void) {
-  static auto instance = std::make_shared<PseudoRandomNumberGenerator>();
+// 64-bit FNV-1a: a fixed, platform-independent stream id for each key.
+static uint64_t StreamId(const std::string& key) {
+  uint64_t hash = 0xCBF29CE484222325u;
+
+  for (const auto character : key) {
+    hash ^= static_cast<uint8_t>(character);
+
+    hash *= 0x100000001B3u;
+  }
 
-  return instance;
+  return hash;
 }
 
+PseudoRandomNumberGenerator::PseudoRandomNumberGenerator(
+    const Engine::Type type)
+    : _type{type}, _seed{0u} {}
+
 uint64_t PseudoRandomNumberGenerator::GetSeed(void) const { return _seed; }
 
 void PseudoRandomNumberGenerator::SetSeed(const uint64_t seed) {
-  this->_generator.seed(seed);
-
   this->_seed = seed;
+
+  for (auto& [key, stream] : _streams) {
+    stream = Engine(_type, _seed, StreamId(key));
+  }
+
+  for (auto& [_, binding] : _distribution) {
+    binding.distribution->Reset();
+  }
 }
 
 void PseudoRandomNumberGenerator::SetRandomSeed(void) {
   SetSeed(_random_device());
 }
 
-void PseudoRandomNumberGenerator::SetExponentialVariable(const std::string key,
-                                                         const double mean) {
-  _distribution[key] = std::make_unique<Exponential>(mean);
+Engine& PseudoRandomNumberGenerator::Stream(const std::string& key) {
+  const auto iterator = _streams.find(key);
+
+  if (iterator != _streams.end()) {
+    return iterator->second;
+  }
+
+  return _streams.try_emplace(key, _type, _seed, StreamId(key)).first->second;
 }
 
-void PseudoRandomNumberGenerator::SetPoissonVariable(const std::string key,
-                                                     const double mean) {
-  _distribution[key] = std::make_unique<Poisson>(mean);
+Variable<Exponential> PseudoRandomNumberGenerator::SetExponentialVariable(
+    const std::string& key, const double mean) {
+  return Bind(key, std::make_unique<Exponential>(mean));
 }
 
-void PseudoRandomNumberGenerator::SetNormalVariable(const std::string key,
-                                                    const double mean,
-                                                    const double deviation) {
-  _distribution[key] = std::make_unique<Normal>(mean, deviation);
+Variable<Poisson> PseudoRandomNumberGenerator::SetPoissonVariable(
+    const std::string& key, const double mean) {
+  return Bind(key, std::make_unique<Poisson>(mean));
 }
 
-void PseudoRandomNumberGenerator::SetUniformVariable(const std::string key,
-                                                     const double min,
-                                                     const double max) {
-  _distribution[key] = std::make_unique<Uniform>(min, max);
+Variable<Normal> PseudoRandomNumberGenerator::SetNormalVariable(
+    const std::string& key, const double mean, const double deviation) {
+  return Bind(key, std::make_unique<Normal>(mean, deviation));
 }
 
-double PseudoRandomNumberGenerator::Next(const std::string key) {
-  return _distribution.at(key)->Next(_generator);
+Variable<Uniform> PseudoRandomNumberGenerator::SetUniformVariable(
+    const std::string& key, const double min, const double max) {
+  return Bind(key, std::make_unique<Uniform>(min, max));
+}
+
+double PseudoRandomNumberGenerator::Next(const std::string& key) {
+  auto& [distribution, stream] = _distribution.at(key);
+
+  return distribution->Next(*stream);
+}
+
+uint64_t SplitMix64(uint64_t value) {
+  value += 0x9E3779B97F4A7C15u;
+
+  value = (value ^ (value >> 30u)) * 0xBF58476D1CE4E5B9u;
+
+  value = (value ^ (value >> 27u)) * 0x94D049BB133111EBu;
+
+  return value ^ (value >> 31u);
 }
 }  // namespace prng
@@ -4,19 +4,41 @@
 #include <random>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
+#include "alias.h"
+#include "block.h"
 #include "discrete.h"
 #include "distribution.h"
+#include "engine.h"
+#include "exponential.h"
+#include "normal.h"
+#include "poisson.h"
+#include "uniform.h"
+#include "variable.h"
 
 namespace prng {
+// Owns a set of named random variables. Every key draws from its own stream,
+// derived from the master seed and the key alone, so the sequence seen by one
+// variable does not depend on how often the others are sampled and separate
+// generators never need to coordinate.
+//
+// Keys are meant for configuration time: the Set*Variable calls return a
+// typed handle for hot paths, while Next(key) remains for occasional draws.
 class PseudoRandomNumberGenerator final {
-  std::unordered_map<std::string, std::unique_ptr<Distribution>> _distribution;
-  std::mt19937 _generator;
+  struct Binding final {
+    std::unique_ptr<Distribution> distribution;
+    Engine* stream;
+  };
+
+  std::unordered_map<std::string, Binding> _distribution;
+  std::unordered_map<std::string, Engine> _streams;
   std::random_device _random_device;
+  Engine::Type _type;
   uint64_t _seed;
 
  public:
-  static std::shared_ptr<PseudoRandomNumberGenerator> Instance(void);
+  PseudoRandomNumberGenerator(const Engine::Type = Engine::Type::Philox);
 
   [[nodiscard]] uint64_t GetSeed(void) const;
 
@@ -24,20 +46,45 @@ class PseudoRandomNumberGenerator final {
 
   void SetRandomSeed(void);
 
-  void SetExponentialVariable(const std::string, const double);
+  [[nodiscard]] Engine& Stream(const std::string&);
+
+  Variable<Exponential> SetExponentialVariable(const std::string&,
+                                               const double);
 
-  void SetPoissonVariable(const std::string, const double);
+  Variable<Poisson> SetPoissonVariable(const std::string&, const double);
 
-  void SetNormalVariable(const std::string, const double, const double);
+  Variable<Normal> SetNormalVariable(const std::string&, const double,
+                                     const double);
 
   template <typename Iterator>
-  void SetDiscreteVariable(const std::string key, Iterator begin,
-                           Iterator end) {
-    _distribution[key] = std::make_unique<Discrete>(begin, end);
+  Variable<Discrete> SetDiscreteVariable(const std::string& key,
+                                         Iterator begin, Iterator end) {
+    return Bind(key, std::make_unique<Discrete>(begin, end));
+  }
+
+  Variable<Uniform> SetUniformVariable(const std::string&, const double,
+                                       const double);
+
+  template <typename T, typename... Args>
+  Variable<T> SetVariable(const std::string& key, Args&&... args) {
+    return Bind(key, std::make_unique<T>(std::forward<Args>(args)...));
   }
 
-  void SetUniformVariable(const std::string, const double, const double);
+  [[nodiscard]] double Next(const std::string&);
 
-  [[nodiscard]] double Next(const std::string);
+ private:
+  template <typename T>
+  Variable<T> Bind(const std::string& key, std::unique_ptr<T> distribution) {
+    auto& stream = Stream(key);
+
+    auto& reference = *distribution;
+
+    _distribution[key] = {std::move(distribution), &stream};
+
+    return Variable<T>(reference, stream);
+  }
 };
+
+// SplitMix64 finalizer, used to spread a master seed over replications.
+[[nodiscard]] uint64_t SplitMix64(uint64_t);
 }  // namespace prng
@@ -4,7 +4,7 @@ namespace prng {
 Uniform::Uniform(const double min, const double max)
     : _distribution{min, max} {}
 
-double Uniform::Next(std::mt19937& generator) {
+double Uniform::Next(Engine& generator) {
   return _distribution(generator);
 }
 }  // namespace prng
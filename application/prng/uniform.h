@@ -11,7 +11,7 @@ class Uniform final : public Distribution {
  public:
   Uniform(const double, const double);
 
-  [[nodiscard]] double Next(std::mt19937&) override;
+  [[nodiscard]] double Next(Engine&) override;
 };
 
 }  // namespace prng
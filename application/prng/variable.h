@@ -0,0 +1,29 @@
+#pragma once
+
+#include "engine.h"
+
+namespace prng {
+// Typed handle on a random variable owned by a PseudoRandomNumberGenerator.
+// Draws go straight to the concrete (final) distribution and its stream, with
+// no key lookup and no virtual dispatch. A handle stays valid until its key
+// is set again or the generator is destroyed.
+template <typename T>
+class Variable final {
+ public:
+  Variable(void) = default;
+
+  Variable(T& distribution, Engine& stream)
+      : distribution{&distribution}, stream{&stream} {}
+
+  [[nodiscard]] double Next(void) const { return distribution->Next(*stream); }
+
+  // Outcome index, for distributions over a finite set such as Alias.
+  [[nodiscard]] uint64_t Sample(void) const {
+    return distribution->Sample(*stream);
+  }
+
+ private:
+  T* distribution;
+  Engine* stream;
+};
+}  // namespace prng
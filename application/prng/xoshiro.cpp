@@ -0,0 +1,15 @@
+#include "xoshiro.h"
+
+#include "prng.h"
+
+namespace prng {
+Xoshiro::Xoshiro(const uint64_t seed, const uint64_t stream) {
+  auto value = seed ^ SplitMix64(stream);
+
+  for (auto& word : state) {
+    word = SplitMix64(value);
+
+    value += 0x9E3779B97F4A7C15u;
+  }
+}
+}  // namespace prng
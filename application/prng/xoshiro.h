@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace prng {
+// xoshiro256++ (Blackman & Vigna, 2019): four words of state and a handful of
+// shifts and adds per output, which makes it the cheapest engine to drain in
+// bulk. The state is expanded from (seed, stream) through SplitMix64.
+class Xoshiro final {
+ public:
+  using result_type = uint64_t;
+
+  Xoshiro(const uint64_t, const uint64_t);
+
+  [[nodiscard]] static constexpr result_type min(void) noexcept {
+    return std::numeric_limits<result_type>::min();
+  }
+
+  [[nodiscard]] static constexpr result_type max(void) noexcept {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()(void) noexcept {
+    const auto result = Rotate(state[0] + state[3], 23u) + state[0];
+
+    const auto t = state[1] << 17u;
+
+    state[2] ^= state[0];
+
+    state[3] ^= state[1];
+
+    state[1] ^= state[2];
+
+    state[0] ^= state[3];
+
+    state[2] ^= t;
+
+    state[3] = Rotate(state[3], 45u);
+
+    return result;
+  }
+
+ private:
+  std::array<uint64_t, 4> state;
+
+  [[nodiscard]] static constexpr uint64_t Rotate(const uint64_t value,
+                                                 const uint32_t k) noexcept {
+    return (value << k) | (value >> (64u - k));
+  }
+};
+}  // namespace prng
@@ -0,0 +1,168 @@
+#include <core/continuity.h>
+#include <core/kernel.h>
+#include <core/spectrum.h>
+#include <gtest/gtest.h>
+#include <prng/engine.h>
+#include <test/fixture.h>
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Counts every heap allocation the binary makes, so a test can check that a
+// code path stays off the heap. The replacement is global, which is why these
+// tests are built apart from the others.
+static std::atomic<uint64_t> allocations{0u};
+
+void* operator new(const std::size_t size) {
+  ++allocations;
+
+  if (auto* pointer = std::malloc(size ? size : 1u)) {
+    return pointer;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, const std::size_t) noexcept {
+  std::free(pointer);
+}
+
+TEST(Allocation, SpectrumPathStaysOffTheHeap) {
+  constexpr uint64_t FSUsPerLink = 320u;
+
+  std::vector<core::Spectrum> carriers(4u, core::Spectrum(FSUsPerLink));
+
+  const std::vector<graph::EdgeId> links{0u, 1u, 2u, 3u};
+
+  prng::Engine engine(prng::Engine::Type::Xoshiro, 37u, 0u);
+
+  std::vector<core::RequestType> types;
+
+  std::vector<core::SpectrumAllocator> allocators;
+
+  for (const auto& allocation :
+       {"best-fit", "first-fit", "last-fit", "random-fit", "worst-fit"}) {
+    for (const auto search :
+         {core::SpectrumSearch::List, core::FastestSpectrumSearch()}) {
+      core::RequestType type{};
+
+      type.FSUs = 2u + types.size() % 7u;
+
+      type.policy = core::SpectrumAllocatorFactory::Policy(allocation);
+
+      type.id = static_cast<uint32_t>(types.size());
+
+      allocators.push_back(core::SpectrumAllocatorFactory::CreateAllocator(
+          allocation, engine, search));
+
+      types.push_back(type);
+    }
+  }
+
+  core::ContinuityEngine list(FSUsPerLink, core::SpectrumSearch::List,
+                              allocators);
+
+  core::ContinuityEngine bitmap(FSUsPerLink, core::FastestSpectrumSearch(),
+                                allocators);
+
+  const core::AbsoluteFragmentation absolute;
+
+  const core::EntropyBasedFragmentation entropy(2u);
+
+  const core::ExternalFragmentation external;
+
+  std::array<std::optional<core::Slice>, 48> active;
+
+  auto sum = 0.0;
+
+  const auto run = [&](const uint64_t rounds) {
+    for (auto round = 0u; round < rounds; ++round) {
+      auto& slot = active[round % active.size()];
+
+      if (slot.has_value()) {
+        for (const auto link : links) {
+          carriers[link].deallocate(slot.value());
+        }
+
+        slot.reset();
+      }
+
+      const auto& type = types[round % types.size()];
+
+      auto& continuity = round % 2u ? list : bitmap;
+
+      slot = continuity.Allocate(carriers, links, type);
+
+      if (slot.has_value()) {
+        for (const auto link : links) {
+          carriers[link].allocate(slot.value());
+        }
+      }
+
+      const auto& allocator = allocators[type.id];
+
+      for (auto& spectrum : carriers) {
+        sum += allocator(spectrum, type.FSUs).value_or(core::Slice{}).first;
+
+        sum += absolute(spectrum) + entropy(spectrum) + external(spectrum);
+
+        const auto tentative = allocator(spectrum, 1u);
+
+        if (tentative.has_value()) {
+          spectrum.begin_transaction();
+
+          spectrum.allocate(tentative.value());
+
+          sum += absolute(spectrum);
+
+          spectrum.rollback();
+        }
+      }
+    }
+  };
+
+  // The first rounds grow the run arrays, journals and search scratch to
+  // their working size; after that nothing may touch the heap.
+  run(2000u);
+
+  const auto before = allocations.load();
+
+  run(2000u);
+
+  ASSERT_EQ(allocations.load(), before);
+
+  ASSERT_GT(sum, 0.0);
+}
+
+TEST(Allocation, WarmKernelStaysOffTheHeap) {
+  // The calendar queue is the default.
+  for (const std::string scheduler : {"calendar", "heap"}) {
+    const auto configuration = fixture::Nsfnet({{"scheduler", scheduler}});
+
+    const auto duration = configuration->timeUnits;
+
+    core::Kernel kernel(configuration, configuration->seed);
+
+    // The first half of the run grows the event queue, the request pool and
+    // the search scratch to their working size; the second half picks up
+    // where it stopped and may not touch the heap.
+    configuration->timeUnits = duration / 2.0;
+
+    kernel.Run();
+
+    configuration->timeUnits = duration;
+
+    const auto before = allocations.load();
+
+    kernel.Run();
+
+    ASSERT_EQ(allocations.load(), before) << scheduler;
+  }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <core/configuration.h>
+#include <core/json.h>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <string>
+
+// Configurations shared by the tests and the benchmarks.
+namespace fixture {
+// Low- and high-demand BPSK requests in equal shares, with the given
+// allocators.
+inline nlohmann::json Requests(const std::string& low,
+                               const std::string& high) {
+  return nlohmann::json::array({
+      {{"type", "low-demand"},
+       {"bandwidth", 62.5},
+       {"modulation", "BPSK"},
+       {"allocator", low},
+       {"ratio", 0.5}},
+      {{"type", "high-demand"},
+       {"bandwidth", 162.5},
+       {"modulation", "BPSK"},
+       {"allocator", high},
+       {"ratio", 0.5}},
+  });
+}
+
+// A loaded nsfnet, with params merged over the defaults. Configuration only
+// reads from files, so the JSON goes through a temporary one; its name is
+// drawn at random so that concurrent test and benchmark runs never read each
+// other's.
+inline std::shared_ptr<core::Configuration> Nsfnet(
+    const nlohmann::json& params = nlohmann::json::object()) {
+  nlohmann::json json{
+      {"enable-logging", false},
+      {"export-dataset", false},
+      {"params",
+       {{"agent", "classic"},
+        {"arrival-rate", 1.0},
+        {"ignore-first", false},
+        {"iterations", 1},
+        {"sampling-time", 100},
+        {"service-rate", 0.02},
+        {"modulation", "passband"},
+        {"requests", Requests("first-fit", "last-fit")},
+        {"seed", 1},
+        {"simulation-duration", 20'000.0},
+        {"slot-width", 12.5},
+        {"spectrum-width", 4000},
+        {"topology", RESOURCES "/graph/nsfnet.txt"}}},
+      {"modulation",
+       nlohmann::json::array({{{"type", "BPSK"}, {"bits-per-symbol", 1}}})},
+  };
+
+  json["params"].update(params);
+
+  std::random_device device;
+
+  const auto path =
+      std::filesystem::temp_directory_path() /
+      std::format("configuration-{:08x}{:08x}.json", device(), device());
+
+  std::ofstream(path) << json.dump();
+
+  const auto configuration = core::Configuration::From(core::Json(path));
+
+  std::filesystem::remove(path);
+
+  return configuration.value();
+}
+}  // namespace fixture
@@ -0,0 +1,40 @@
+#include <core/kernel.h>
+#include <gtest/gtest.h>
+#include <test/fixture.h>
+
+#include <memory>
+#include <string>
+
+// The report without its first line, which stamps the wall-clock time.
+static std::string Report(const core::Kernel& kernel) {
+  const auto report = kernel.GetReport().Build();
+
+  return report.substr(report.find('\n') + 1u);
+}
+
+TEST(Kernel, KernelsShareOneConfiguration) {
+  // Loaded enough to block, so the random-fit draws show in the report.
+  const nlohmann::json params{
+      {"requests", fixture::Requests("random-fit", "random-fit")},
+      {"service-rate", 0.002}};
+
+  core::Kernel alone(fixture::Nsfnet(params), 5u);
+
+  alone.Run();
+
+  const auto configuration = fixture::Nsfnet(params);
+
+  core::Kernel kernel(configuration, 5u);
+
+  {
+    // Built, run and destroyed on the same configuration in between: its
+    // random-fit draws must neither reach nor outlive the first kernel's.
+    core::Kernel other(configuration, 3u);
+
+    other.Run();
+  }
+
+  kernel.Run();
+
+  ASSERT_EQ(Report(kernel), Report(alone));
+}
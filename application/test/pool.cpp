@@ -0,0 +1,71 @@
+#include <core/pool.h>
+#include <core/request.h>
+#include <core/scheduler.h>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <type_traits>
+
+TEST(Pool, EventIsSlim) {
+  ASSERT_LE(sizeof(core::Event), 24u);
+
+  ASSERT_TRUE(std::is_trivially_copyable_v<core::Event>);
+
+  ASSERT_TRUE(std::is_trivially_destructible_v<core::Request>);
+}
+
+TEST(Pool, AcquireAndRelease) {
+  core::Pool<uint64_t> pool;
+
+  const auto first = pool.acquire(1u);
+
+  const auto second = pool.acquire(2u);
+
+  ASSERT_EQ(pool.size(), 2u);
+
+  ASSERT_EQ(pool.at(first), 1u);
+
+  ASSERT_EQ(pool.at(second), 2u);
+
+  pool.release(first);
+
+  ASSERT_EQ(pool.size(), 1u);
+
+  ASSERT_FALSE(pool.contains(first));
+
+  ASSERT_TRUE(pool.contains(second));
+}
+
+TEST(Pool, RecyclesSlotsWithNewGeneration) {
+  core::Pool<uint64_t> pool;
+
+  const auto stale = pool.acquire(1u);
+
+  pool.release(stale);
+
+  const auto fresh = pool.acquire(3u);
+
+  ASSERT_EQ(fresh.index, stale.index);
+
+  ASSERT_NE(fresh.generation, stale.generation);
+
+  ASSERT_EQ(pool.capacity(), 1u);
+
+  ASSERT_THROW((void)pool.at(stale), std::out_of_range);
+
+  ASSERT_EQ(pool.at(fresh), 3u);
+}
+
+TEST(Pool, ClearInvalidatesHandles) {
+  core::Pool<uint64_t> pool;
+
+  const auto handle = pool.acquire(1u);
+
+  pool.clear();
+
+  ASSERT_EQ(pool.size(), 0u);
+
+  ASSERT_FALSE(pool.contains(handle));
+
+  ASSERT_EQ(pool.capacity(), 1u);
+}
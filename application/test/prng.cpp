@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+#include <prng/block.h>
+#include <prng/engine.h>
+#include <prng/philox.h>
+#include <prng/prng.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+TEST(Prng, PhiloxKnownAnswer) {
+  prng::Philox philox(0u, 0u);
+
+  ASSERT_EQ(philox(), 0xE169C58D6627E8D5u);
+
+  ASSERT_EQ(philox(), 0x9B00DBD8BC57AC4Cu);
+}
+
+TEST(Prng, StreamsAreIndependentOfEachOther) {
+  prng::PseudoRandomNumberGenerator first;
+
+  prng::PseudoRandomNumberGenerator second;
+
+  first.SetSeed(42u);
+
+  second.SetSeed(42u);
+
+  first.SetExponentialVariable("arrival", 1.0);
+
+  first.SetExponentialVariable("service", 1.0);
+
+  second.SetExponentialVariable("service", 1.0);
+
+  for (auto index = 0u; index < 100u; ++index) {
+    (void)first.Next("arrival");
+  }
+
+  for (auto index = 0u; index < 100u; ++index) {
+    ASSERT_EQ(first.Next("service"), second.Next("service"));
+  }
+}
+
+TEST(Prng, SeedRestartsStreams) {
+  for (const auto type :
+       {prng::Engine::Type::MersenneTwister, prng::Engine::Type::Philox}) {
+    prng::PseudoRandomNumberGenerator generator(type);
+
+    generator.SetSeed(7u);
+
+    generator.SetUniformVariable("routing", 0.0, 1.0);
+
+    const auto expected = generator.Next("routing");
+
+    generator.SetSeed(7u);
+
+    ASSERT_EQ(generator.Next("routing"), expected);
+
+    generator.SetSeed(8u);
+
+    ASSERT_NE(generator.Next("routing"), expected);
+  }
+}
+
+TEST(Prng, HandleMatchesKeyedDraws) {
+  prng::PseudoRandomNumberGenerator keyed;
+
+  prng::PseudoRandomNumberGenerator handled;
+
+  keyed.SetSeed(3u);
+
+  handled.SetSeed(3u);
+
+  keyed.SetExponentialVariable("service", 0.5);
+
+  const auto service = handled.SetExponentialVariable("service", 0.5);
+
+  for (auto index = 0u; index < 100u; ++index) {
+    ASSERT_EQ(keyed.Next("service"), service.Next());
+  }
+}
+
+TEST(Prng, ExponentialBlockMean) {
+  prng::PseudoRandomNumberGenerator generator(prng::Engine::Type::Xoshiro);
+
+  generator.SetSeed(11u);
+
+  const auto variable =
+      generator.SetVariable<prng::ExponentialBlock>("service", 0.25);
+
+  constexpr auto draws = 4u * prng::Block::Size;
+
+  auto sum = 0.0;
+
+  for (auto index = 0u; index < draws; ++index) {
+    const auto value = variable.Next();
+
+    ASSERT_GE(value, 0.0);
+
+    sum += value;
+  }
+
+  EXPECT_NEAR(sum / draws, 4.0, 0.2);
+}
+
+TEST(Prng, ExponentialBlockMatchesLibraryLogarithm) {
+  prng::ExponentialBlock block(1.0);
+
+  prng::Engine engine(prng::Engine::Type::Xoshiro, 13u, 0u);
+
+  prng::Engine reference(prng::Engine::Type::Xoshiro, 13u, 0u);
+
+  for (auto index = 0u; index < prng::Block::Size; ++index) {
+    const auto u = static_cast<double>(reference() >> 11u) * 0x1.0p-53;
+
+    const auto expected = -std::log(1.0 - u);
+
+    ASSERT_NEAR(block.Next(engine), expected, 1e-15 * (1.0 + expected));
+  }
+}
+
+TEST(Prng, BelowIsUniformAndBounded) {
+  prng::Engine engine(prng::Engine::Type::Xoshiro, 41u, 0u);
+
+  std::vector<uint64_t> counts(6u, 0u);
+
+  constexpr auto draws = 60'000u;
+
+  for (auto index = 0u; index < draws; ++index) {
+    const auto value = engine.Below(counts.size());
+
+    ASSERT_LT(value, counts.size());
+
+    ++counts[value];
+  }
+
+  for (const auto count : counts) {
+    EXPECT_NEAR(static_cast<double>(count) / draws, 1.0 / 6.0, 0.01);
+  }
+
+  ASSERT_EQ(engine.Below(1u), 0u);
+
+  // A bound past 2^63 rejects almost half of the raw draws.
+  for (auto index = 0u; index < 100u; ++index) {
+    ASSERT_LT(engine.Below((1ull << 63u) + 1u), (1ull << 63u) + 1u);
+  }
+}
+
+TEST(Prng, DiscreteBlockFrequencies) {
+  prng::PseudoRandomNumberGenerator generator;
+
+  generator.SetSeed(5u);
+
+  const std::vector<double> weights{0.2, 0.0, 0.8};
+
+  const auto variable = generator.SetVariable<prng::DiscreteBlock>(
+      "fsus", weights.begin(), weights.end());
+
+  std::vector<uint64_t> counts(weights.size(), 0u);
+
+  constexpr auto draws = 10u * prng::Block::Size;
+
+  for (auto index = 0u; index < draws; ++index) {
+    ++counts[static_cast<uint64_t>(variable.Next())];
+  }
+
+  ASSERT_EQ(counts[1], 0u);
+
+  EXPECT_NEAR(static_cast<double>(counts[0]) / draws, 0.2, 0.01);
+
+  EXPECT_NEAR(static_cast<double>(counts[2]) / draws, 0.8, 0.01);
+}
+
+TEST(Prng, AliasFrequencies) {
+  prng::Engine engine(prng::Engine::Type::Philox, 17u, 0u);
+
+  const std::vector<double> weights{1.0, 0.0, 6.0, 3.0};
+
+  const prng::Alias alias(weights.begin(), weights.end());
+
+  std::vector<uint64_t> counts(weights.size(), 0u);
+
+  constexpr auto draws = 100'000u;
+
+  for (auto index = 0u; index < draws; ++index) {
+    ++counts[alias.Sample(engine)];
+  }
+
+  ASSERT_EQ(counts[1], 0u);
+
+  EXPECT_NEAR(static_cast<double>(counts[0]) / draws, 0.1, 0.005);
+
+  EXPECT_NEAR(static_cast<double>(counts[2]) / draws, 0.6, 0.005);
+
+  EXPECT_NEAR(static_cast<double>(counts[3]) / draws, 0.3, 0.005);
+}
+
+TEST(Prng, AliasCoversLargeTables) {
+  prng::Engine engine(prng::Engine::Type::Xoshiro, 19u, 0u);
+
+  std::vector<double> weights(2256u);
+
+  for (auto index = 0u; index < weights.size(); ++index) {
+    weights[index] = 1.0 + index % 3u;
+  }
+
+  const prng::Alias alias(weights.begin(), weights.end());
+
+  ASSERT_EQ(alias.size(), weights.size());
+
+  std::vector<uint64_t> counts(weights.size(), 0u);
+
+  for (auto index = 0u; index < 200u * weights.size(); ++index) {
+    ++counts[alias.Sample(engine)];
+  }
+
+  // Each outcome expects 100, 200 or 300 hits; none may be starved.
+  for (auto index = 0u; index < weights.size(); ++index) {
+    EXPECT_GT(counts[index], 50u * (1u + index % 3u));
+  }
+}
+
+TEST(Prng, AliasRejectsInvalidWeights) {
+  const std::vector<double> empty;
+
+  const std::vector<double> zero{0.0, 0.0};
+
+  const std::vector<double> negative{1.0, -1.0};
+
+  ASSERT_THROW(prng::Alias(empty.begin(), empty.end()), std::invalid_argument);
+
+  ASSERT_THROW(prng::Alias(zero.begin(), zero.end()), std::invalid_argument);
+
+  ASSERT_THROW(prng::Alias(negative.begin(), negative.end()),
+               std::invalid_argument);
+}
+
+TEST(Prng, SeedDiscardsBufferedVariates) {
+  prng::PseudoRandomNumberGenerator generator;
+
+  generator.SetSeed(9u);
+
+  const auto variable =
+      generator.SetVariable<prng::UniformBlock>("routing", 0.0, 1.0);
+
+  const auto expected = variable.Next();
+
+  generator.SetSeed(9u);
+
+  ASSERT_EQ(variable.Next(), expected);
+}
@@ -0,0 +1,438 @@
+#include <core/traffic.h>
+#include <graph/bfs.h>
+#include <graph/dijkstra.h>
+#include <graph/graph.h>
+#include <graph/ksp.h>
+#include <graph/path.h>
+#include <graph/radix.h>
+#include <graph/table.h>
+#include <gtest/gtest.h>
+#include <prng/engine.h>
+
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// 0 -> 1 -> 2 is cheaper than the direct 0 -> 2 edge; 3 is isolated.
+static graph::Graph Diamond(void) {
+  return graph::Graph(4u, {{0u, 1u, 1.0}, {1u, 2u, 1.0}, {0u, 2u, 5.0},
+                           {2u, 0u, 1.0}});
+}
+
+TEST(Route, DijkstraReturnsOrderedPath) {
+  const auto graph = Diamond();
+
+  const auto route = graph::Dijkstra(graph).compute(0u, 2u);
+
+  ASSERT_TRUE(route.has_value());
+
+  const std::vector<graph::Vertex> expected{0u, 1u, 2u};
+
+  ASSERT_EQ(route->vertices, expected);
+
+  const std::vector<graph::EdgeId> links{graph.edge_id(0u, 1u),
+                                         graph.edge_id(1u, 2u)};
+
+  ASSERT_EQ(route->links, links);
+
+  ASSERT_DOUBLE_EQ(route->cost.value, 2.0);
+}
+
+TEST(Route, DijkstraReusesStateAcrossQueries) {
+  prng::Engine engine(prng::Engine::Type::Philox, 1u, 0u);
+
+  constexpr uint64_t vertices = 64u;
+
+  // Small integer weights, so equal-cost paths that differ in hops abound.
+  std::vector<graph::Edge> edges;
+
+  for (auto edge = 0u; edge < 4u * vertices; ++edge) {
+    edges.emplace_back(engine.Below(vertices), engine.Below(vertices),
+                       static_cast<double>(engine.Below(4u)));
+  }
+
+  const graph::Graph graph(vertices, edges);
+
+  std::vector<std::vector<double>> distances(
+      vertices, std::vector(vertices, std::numeric_limits<double>::max()));
+
+  for (auto vertex = 0u; vertex < vertices; ++vertex) {
+    distances[vertex][vertex] = 0.0;
+  }
+
+  for (const auto& [source, destination, cost] : edges) {
+    distances[source][destination] =
+        std::min(distances[source][destination], cost.value);
+  }
+
+  for (auto middle = 0u; middle < vertices; ++middle) {
+    for (auto source = 0u; source < vertices; ++source) {
+      for (auto destination = 0u; destination < vertices; ++destination) {
+        const auto first = distances[source][middle];
+
+        const auto second = distances[middle][destination];
+
+        if (first != std::numeric_limits<double>::max() &&
+            second != std::numeric_limits<double>::max()) {
+          distances[source][destination] =
+              std::min(distances[source][destination], first + second);
+        }
+      }
+    }
+  }
+
+  const graph::Dijkstra reused(graph);
+
+  for (auto source = 0u; source < vertices; ++source) {
+    for (auto destination = 0u; destination < vertices; ++destination) {
+      const auto route = reused.compute(source, destination);
+
+      const auto fresh = graph::Dijkstra(graph).compute(source, destination);
+
+      ASSERT_EQ(route.has_value(), fresh.has_value());
+
+      ASSERT_EQ(route.has_value(), distances[source][destination] !=
+                                       std::numeric_limits<double>::max());
+
+      if (route.has_value()) {
+        ASSERT_EQ(route->links, fresh->links);
+
+        ASSERT_DOUBLE_EQ(route->cost.value, distances[source][destination]);
+      }
+    }
+  }
+}
+
+TEST(Route, RadixHeapPopsInOrder) {
+  prng::Engine engine(prng::Engine::Type::Philox, 2u, 0u);
+
+  graph::RadixHeap heap;
+
+  graph::RadixHeap::Key last = 0u;
+
+  // Interleaved pushes never go below the last key popped, as in Dijkstra.
+  for (auto round = 0u; round < 1'000u; ++round) {
+    for (auto push = 0u; push < 3u; ++push) {
+      heap.push(last + (static_cast<graph::RadixHeap::Key>(engine.Below(8u))
+                        << (engine.Below(2u) * 64u)) +
+                engine.Below(1'000u));
+    }
+
+    const auto key = heap.pop();
+
+    ASSERT_GE(key, last);
+
+    last = key;
+  }
+
+  while (!heap.empty()) {
+    const auto key = heap.pop();
+
+    ASSERT_GE(key, last);
+
+    last = key;
+  }
+}
+
+TEST(Route, DijkstraRejectsUnreachable) {
+  const auto graph = Diamond();
+
+  ASSERT_FALSE(graph::Dijkstra(graph).compute(0u, 3u).has_value());
+
+  ASSERT_FALSE(graph::Dijkstra(graph).compute(3u, 0u).has_value());
+}
+
+TEST(Route, TableIndexesEveryPair) {
+  const auto graph = Diamond();
+
+  const graph::RouteTable table(graph, graph::Dijkstra(graph));
+
+  ASSERT_EQ(table.size(), 4u);
+
+  ASSERT_EQ(table.paths(), 1u);
+
+  ASSERT_EQ(table.at(0u, 0u), graph::NullPath);
+
+  ASSERT_EQ(table.at(0u, 3u), graph::NullPath);
+
+  ASSERT_EQ(table.count(table.index(0u, 3u)), 0u);
+
+  const auto path = table.path(table.at(1u, 0u));
+
+  const std::vector<graph::EdgeId> links{graph.edge_id(1u, 2u),
+                                         graph.edge_id(2u, 0u)};
+
+  const std::vector<graph::Vertex> vertices{1u, 2u, 0u};
+
+  ASSERT_TRUE(std::ranges::equal(path.links, links));
+
+  ASSERT_TRUE(std::ranges::equal(path.vertices, vertices));
+
+  ASSERT_EQ(path.hops(), 2u);
+
+  ASSERT_DOUBLE_EQ(path.cost.value, 2.0);
+
+  ASSERT_EQ(table.route(table.index(0u, 2u), 0u), table.at(0u, 2u));
+}
+
+TEST(Route, TableRefusesPairsPast32Bits) {
+  // 2^16 vertices make 2^32 pairs, one more than a 32-bit index can name.
+  const graph::Graph graph(65536u);
+
+  ASSERT_THROW(graph::RouteTable(graph, 1u, 1u), std::length_error);
+
+  ASSERT_THROW(graph::RouteTable(graph, graph::Dijkstra(graph)),
+               std::length_error);
+}
+
+TEST(Route, PathPoolInternsPaths) {
+  const auto graph = Diamond();
+
+  const graph::Dijkstra dijkstra(graph);
+
+  graph::PathPool pool;
+
+  const auto first = pool.intern(dijkstra.compute(0u, 2u).value());
+
+  const auto second = pool.intern(dijkstra.compute(2u, 1u).value());
+
+  ASSERT_NE(first, second);
+
+  ASSERT_EQ(pool.intern(dijkstra.compute(0u, 2u).value()), first);
+
+  ASSERT_EQ(pool.size(), 2u);
+
+  // Paths sit back to back in the shared buffers.
+  ASSERT_EQ(pool[first].links.data() + pool[first].hops(),
+            pool[second].links.data());
+
+  ASSERT_EQ(pool[first].vertices.data() + pool[first].hops() + 1u,
+            pool[second].vertices.data());
+
+  const std::vector<graph::Vertex> vertices{2u, 0u, 1u};
+
+  ASSERT_TRUE(std::ranges::equal(pool[second].vertices, vertices));
+
+  ASSERT_DOUBLE_EQ(pool[second].cost.value, 2.0);
+}
+
+// Link IDs of a pair's route of the given rank, empty when there is none.
+static std::span<const graph::EdgeId> Links(const graph::RouteTable& table,
+                                            const uint64_t pair,
+                                            const uint64_t rank) {
+  const auto id = table.route(pair, rank);
+
+  return id == graph::NullPath ? std::span<const graph::EdgeId>()
+                               : table.path(id).links;
+}
+
+TEST(Route, ParallelTableMatchesSerial) {
+  const auto graph = graph::Graph::from(RESOURCES "/graph/nsfnet.txt").value();
+
+  const graph::RouteTable serial(graph, graph::Dijkstra(graph));
+
+  for (const auto threads : {1u, 3u, 8u}) {
+    const graph::RouteTable parallel(graph, 1u, threads);
+
+    for (auto pair = 0u; pair < graph.size() * graph.size(); ++pair) {
+      ASSERT_TRUE(std::ranges::equal(Links(parallel, pair, 0u),
+                                     Links(serial, pair, 0u)));
+    }
+
+    ASSERT_EQ(parallel.memory(), serial.memory());
+  }
+
+  // Alternatives follow the shortest route, no cheaper than it.
+  const graph::RouteTable table(graph, 3u, 2u);
+
+  for (auto pair = 0u; pair < graph.size() * graph.size(); ++pair) {
+    ASSERT_TRUE(
+        std::ranges::equal(Links(table, pair, 0u), Links(serial, pair, 0u)));
+
+    for (auto rank = 1u; rank < table.count(pair); ++rank) {
+      ASSERT_LE(table.path(table.route(pair, rank - 1u)).cost.value,
+                table.path(table.route(pair, rank)).cost.value);
+    }
+  }
+}
+
+// Every simple path between two vertices, by exhaustive depth-first search.
+static void Enumerate(const graph::Graph& graph, const graph::Vertex vertex,
+                      const graph::Vertex destination,
+                      std::vector<bool>& visited, const double cost,
+                      std::vector<double>& costs) {
+  if (vertex == destination) {
+    costs.push_back(cost);
+
+    return;
+  }
+
+  visited[vertex] = true;
+
+  const auto adjacents = graph.adjacent(vertex);
+
+  for (auto index = 0u; index < adjacents.size(); ++index) {
+    if (!visited[adjacents[index]]) {
+      Enumerate(graph, adjacents[index], destination, visited,
+                cost + graph.weights(vertex)[index].value, costs);
+    }
+  }
+
+  visited[vertex] = false;
+}
+
+TEST(Route, KShortestPathsMatchExhaustiveSearch) {
+  prng::Engine engine(prng::Engine::Type::Philox, 3u, 0u);
+
+  constexpr uint64_t vertices = 8u;
+
+  constexpr uint64_t k = 6u;
+
+  std::vector<graph::Edge> edges;
+
+  for (auto source = 0u; source < vertices; ++source) {
+    for (auto destination = 0u; destination < vertices; ++destination) {
+      if (source != destination && engine.Below(3u) == 0u) {
+        edges.emplace_back(source, destination,
+                           static_cast<double>(1u + engine.Below(5u)));
+      }
+    }
+  }
+
+  const graph::Graph graph(vertices, edges);
+
+  const graph::KShortestPath ksp(graph);
+
+  for (auto source = 0u; source < vertices; ++source) {
+    for (auto destination = 0u; destination < vertices; ++destination) {
+      if (source == destination) {
+        continue;
+      }
+
+      std::vector<bool> visited(vertices, false);
+
+      std::vector<double> expected;
+
+      Enumerate(graph, source, destination, visited, 0.0, expected);
+
+      std::ranges::sort(expected);
+
+      expected.resize(std::min<uint64_t>(expected.size(), k));
+
+      const auto routes = ksp.compute(source, destination, k);
+
+      std::vector<double> costs;
+
+      for (const auto& route : routes) {
+        costs.push_back(route.cost.value);
+      }
+
+      ASSERT_EQ(costs, expected);
+    }
+  }
+}
+
+TEST(Route, KShortestPathsAreLooplessOnFullMesh) {
+  const auto graph =
+      graph::Graph::from(RESOURCES "/graph/nsfnet-full-mesh.txt").value();
+
+  const graph::KShortestPath ksp(graph);
+
+  const auto edges = graph.get_edges();
+
+  for (auto destination = 1u; destination < graph.size(); ++destination) {
+    const auto routes = ksp.compute(0u, destination, 16u);
+
+    ASSERT_EQ(routes.size(), 16u);
+
+    for (auto rank = 0u; rank < routes.size(); ++rank) {
+      const auto& route = routes[rank];
+
+      ASSERT_EQ(route.vertices.front(), 0u);
+
+      ASSERT_EQ(route.vertices.back(), destination);
+
+      ASSERT_EQ(route.links.size() + 1u, route.vertices.size());
+
+      for (auto hop = 0u; hop < route.links.size(); ++hop) {
+        const auto& [from, to, cost] = edges[route.links[hop]];
+
+        ASSERT_EQ(from, route.vertices[hop]);
+
+        ASSERT_EQ(to, route.vertices[hop + 1u]);
+      }
+
+      auto vertices = route.vertices;
+
+      std::ranges::sort(vertices);
+
+      ASSERT_EQ(std::ranges::adjacent_find(vertices), vertices.end());
+
+      for (auto other = 0u; other < rank; ++other) {
+        ASSERT_NE(routes[other].links, route.links);
+
+        ASSERT_LE(routes[other].cost.value, route.cost.value);
+      }
+    }
+  }
+}
+
+TEST(Route, EdgeIdsAreDense) {
+  const auto graph = Diamond();
+
+  ASSERT_EQ(graph.edge_count(), 4u);
+
+  const auto edges = graph.get_edges();
+
+  for (auto id = 0u; id < edges.size(); ++id) {
+    const auto& [source, destination, cost] = edges[id];
+
+    ASSERT_EQ(graph.edge_id(source, destination), id);
+  }
+
+  ASSERT_THROW((void)graph.edge_id(2u, 1u), std::out_of_range);
+}
+
+TEST(Route, AdjacencyIsContiguousPerVertex) {
+  const auto graph = Diamond();
+
+  const std::vector<graph::Vertex> targets{1u, 2u};
+
+  ASSERT_TRUE(std::ranges::equal(graph.adjacent(0u), targets));
+
+  ASSERT_EQ(graph.weights(0u)[1].value, 5.0);
+
+  ASSERT_EQ(graph.links(0u)[1], graph.edge_id(0u, 2u));
+
+  ASSERT_TRUE(graph.adjacent(3u).empty());
+
+  ASSERT_DOUBLE_EQ(graph.at(2u, 0u).value, 1.0);
+
+  ASSERT_FALSE(graph.is_adjacent(2u, 1u));
+
+  ASSERT_THROW(graph::Graph(2u, {{0u, 2u, 1.0}}), std::out_of_range);
+}
+
+TEST(Route, BreadthFirstSearchCostsItsPath) {
+  const auto graph = Diamond();
+
+  const auto route = graph::BreadthFirstSearch(graph).compute(0u, 2u);
+
+  ASSERT_TRUE(route.has_value());
+
+  ASSERT_EQ(route->links, std::vector<graph::EdgeId>{graph.edge_id(0u, 2u)});
+
+  ASSERT_DOUBLE_EQ(route->cost.value, 5.0);
+}
+
+TEST(Route, UniformTrafficSkipsDiagonal) {
+  const core::TrafficMatrix traffic(3u);
+
+  ASSERT_EQ(traffic.weights().size(), 9u);
+
+  ASSERT_EQ(traffic.at(1u, 1u), 0.0);
+
+  ASSERT_EQ(traffic.at(1u, 2u), 1.0);
+}
@@ -0,0 +1,131 @@
+#include <core/scheduler.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+TEST(Scheduler, HeapOrdersByTime) {
+  core::HeapScheduler scheduler;
+
+  for (const auto time : {3.0, 1.0, 2.0}) {
+    scheduler.push(core::Event::MakeArrival(time, {}));
+  }
+
+  ASSERT_EQ(scheduler.pop().time, 1.0);
+
+  ASSERT_EQ(scheduler.pop().time, 2.0);
+
+  ASSERT_EQ(scheduler.pop().time, 3.0);
+
+  ASSERT_TRUE(scheduler.empty());
+}
+
+TEST(Scheduler, CalendarOrdersByTime) {
+  core::CalendarScheduler scheduler;
+
+  std::mt19937 generator(42);
+
+  std::exponential_distribution<double> distribution(0.5);
+
+  std::vector<double> expected;
+
+  for (auto index = 0u; index < 10000u; ++index) {
+    const auto time = distribution(generator);
+
+    expected.push_back(time);
+
+    scheduler.push(core::Event::MakeArrival(time, {}));
+  }
+
+  std::sort(expected.begin(), expected.end());
+
+  ASSERT_EQ(scheduler.size(), expected.size());
+
+  for (const auto time : expected) {
+    ASSERT_EQ(scheduler.top().time, time);
+
+    ASSERT_EQ(scheduler.pop().time, time);
+  }
+
+  ASSERT_TRUE(scheduler.empty());
+}
+
+TEST(Scheduler, CalendarMatchesHeapOnHoldModel) {
+  core::CalendarScheduler calendar;
+
+  core::HeapScheduler heap;
+
+  std::mt19937 generator(7);
+
+  std::exponential_distribution<double> distribution(0.133138064);
+
+  for (auto index = 0u; index < 1000u; ++index) {
+    const auto event = core::Event::MakeDeparture(distribution(generator), {});
+
+    calendar.push(event);
+
+    heap.push(event);
+  }
+
+  for (auto index = 0u; index < 100000u; ++index) {
+    const auto now = heap.pop().time;
+
+    ASSERT_EQ(calendar.pop().time, now);
+
+    const auto event =
+        core::Event::MakeDeparture(now + distribution(generator), {});
+
+    calendar.push(event);
+
+    heap.push(event);
+  }
+
+  ASSERT_EQ(calendar.size(), heap.size());
+}
+
+TEST(Scheduler, CalendarAcceptsEarlierEvents) {
+  core::CalendarScheduler scheduler;
+
+  scheduler.push(core::Event::MakeArrival(100.0, {}));
+
+  scheduler.push(core::Event::MakeArrival(50.0, {}));
+
+  ASSERT_EQ(scheduler.pop().time, 50.0);
+
+  scheduler.push(core::Event::MakeArrival(75.0, {}));
+
+  ASSERT_EQ(scheduler.pop().time, 75.0);
+
+  ASSERT_EQ(scheduler.pop().time, 100.0);
+
+  scheduler.clear();
+
+  ASSERT_TRUE(scheduler.empty());
+}
+
+TEST(Scheduler, CalendarKeepsTieOrderAcrossResizes) {
+  core::CalendarScheduler scheduler;
+
+  // Enough events to grow the calendar several times on the way up and
+  // shrink it again on the way down, over only three distinct times.
+  for (auto index = 0u; index < 200u; ++index) {
+    const auto time = static_cast<double>((index * 7u) % 3u);
+
+    scheduler.push(core::Event::MakeArrival(time, {index, 0u}));
+  }
+
+  auto previous = scheduler.pop();
+
+  while (!scheduler.empty()) {
+    const auto event = scheduler.pop();
+
+    ASSERT_LE(previous.time, event.time);
+
+    if (previous.time == event.time) {
+      ASSERT_LT(previous.request.index, event.request.index);
+    }
+
+    previous = event;
+  }
+}
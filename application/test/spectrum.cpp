@@ -1,6 +1,18 @@
+#include <core/agent.h>
+#include <core/continuity.h>
 #include <core/spectrum.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 TEST(Spectrum, AvailableSlices) {
@@ -15,7 +27,90 @@ TEST(Spectrum, AvailableSlices) {
       {8, 9},
   };
 
-  ASSERT_EQ(spectrum.available_slices(), expected);
+  ASSERT_TRUE(std::ranges::equal(spectrum.available_slices(), expected));
+}
+
+TEST(Spectrum, RollbackRestoresState) {
+  core::Spectrum spectrum(16);
+
+  spectrum.allocate({0, 3});
+
+  spectrum.allocate({8, 9});
+
+  const std::vector<core::Slice> slices(spectrum.available_slices().begin(),
+                                        spectrum.available_slices().end());
+
+  const auto layout = spectrum.Serialize();
+
+  spectrum.begin_transaction();
+
+  spectrum.allocate({4, 6});
+
+  spectrum.deallocate({0, 3});
+
+  spectrum.allocate({12, 15});
+
+  ASSERT_TRUE(spectrum.in_transaction());
+
+  spectrum.rollback();
+
+  ASSERT_FALSE(spectrum.in_transaction());
+
+  ASSERT_TRUE(std::ranges::equal(spectrum.available_slices(), slices));
+
+  ASSERT_EQ(spectrum.Serialize(), layout);
+
+  ASSERT_EQ(spectrum.at(0).occupancy, 1u);
+
+  ASSERT_EQ(spectrum.at(4).occupancy, 0u);
+
+  ASSERT_EQ(spectrum.at(12).occupancy, 0u);
+}
+
+TEST(Spectrum, CommitKeepsChanges) {
+  core::Spectrum spectrum(8);
+
+  spectrum.begin_transaction();
+
+  spectrum.allocate({0, 1});
+
+  spectrum.commit();
+
+  spectrum.begin_transaction();
+
+  spectrum.rollback();
+
+  ASSERT_EQ(spectrum.available(), 6u);
+
+  ASSERT_THROW(
+      {
+        spectrum.begin_transaction();
+
+        spectrum.begin_transaction();
+      },
+      std::logic_error);
+}
+
+TEST(Spectrum, TrialOnlyAllocatesInsideTransactions) {
+  std::vector<core::Spectrum> carriers(2u, core::Spectrum(8));
+
+  const std::span<const core::Spectrum> view(carriers);
+
+  const core::Trial trial(carriers);
+
+  ASSERT_THROW(trial.allocate(1u, {0, 1}), std::logic_error);
+
+  trial.begin(1u);
+
+  trial.allocate(1u, {0, 1});
+
+  ASSERT_EQ(view[1].available(), 6u);
+
+  trial.rollback(1u);
+
+  ASSERT_EQ(view[1].available(), 8u);
+
+  ASSERT_FALSE(view[1].in_transaction());
 }
 
 TEST(Spectrum, AvailableFSUs) {
@@ -85,7 +180,29 @@ TEST(Spectrum, RandomFit) {
 
   spectrum.allocate({5, 7});
 
-  ASSERT_TRUE(core::RandomFit(spectrum, 1).has_value());
+  prng::Engine engine(prng::Engine::Type::Philox, 0u, 0u);
+
+  ASSERT_TRUE(core::RandomFit(spectrum, 1, engine).has_value());
+
+  // Only [2, 4] and [8, 9] fit two FSUs; each is drawn about half the time
+  // and the slice is trimmed to the request.
+  std::array<uint64_t, 10> starts{};
+
+  for (auto draw = 0u; draw < 10'000u; ++draw) {
+    const auto slice = core::RandomFit(spectrum, 2, engine);
+
+    ASSERT_TRUE(slice.has_value());
+
+    ASSERT_EQ(core::size(slice.value()), 2u);
+
+    ++starts[slice->first];
+  }
+
+  ASSERT_EQ(starts[2] + starts[8], 10'000u);
+
+  EXPECT_NEAR(starts[2] / 10'000.0, 0.5, 0.03);
+
+  ASSERT_FALSE(core::RandomFit(spectrum, 4, engine).has_value());
 }
 
 TEST(Spectrum, WorstFit) {
@@ -104,6 +221,227 @@ TEST(Spectrum, WorstFit) {
   ASSERT_EQ(maybe.value(), expected);
 }
 
+TEST(Spectrum, AvailableAt) {
+  core::Spectrum spectrum(10);
+
+  spectrum.allocate({0, 1});
+
+  spectrum.allocate({5, 7});
+
+  ASSERT_TRUE(spectrum.available_at({2, 4}));
+
+  ASSERT_FALSE(spectrum.available_at({3, 5}));
+
+  ASSERT_TRUE(spectrum.available_at({8, 9}));
+
+  ASSERT_FALSE(spectrum.available_at({9, 10}));
+}
+
+TEST(Spectrum, BitmapLayout) {
+  core::Spectrum spectrum(70);
+
+  spectrum.allocate({1, 2});
+
+  spectrum.allocate({63, 64});
+
+  const auto bitmap = spectrum.bitmap();
+
+  ASSERT_EQ(bitmap.size(), 2u);
+
+  ASSERT_EQ(bitmap[0], 0x8000000000000006u);
+
+  // FSUs 70 and up do not exist and read as allocated.
+  ASSERT_EQ(bitmap[1], ~0ull << 6u | 1u);
+
+  spectrum.deallocate({63, 64});
+
+  ASSERT_EQ(bitmap[0], 0x6u);
+}
+
+TEST(Spectrum, BitmapSearchMatchesList) {
+  using Policy = std::pair<core::FitPolicy, core::SpectrumAllocator>;
+
+  const std::vector<Policy> policies{
+      {core::FitPolicy::Best, core::BestFit},
+      {core::FitPolicy::First, core::FirstFit},
+      {core::FitPolicy::Last, core::LastFit},
+      {core::FitPolicy::Worst, core::WorstFit},
+  };
+
+  prng::Engine engine(prng::Engine::Type::Xoshiro, 23u, 0u);
+
+  for (const uint64_t FSUsPerLink : {10u, 64u, 100u, 320u, 1000u}) {
+    core::Spectrum spectrum(FSUsPerLink);
+
+    for (auto round = 0u; round < 40u; ++round) {
+      const auto start = engine() % FSUsPerLink;
+
+      const auto end = std::min(FSUsPerLink - 1u, start + engine() % 12u);
+
+      if (spectrum.available_at({start, end})) {
+        spectrum.allocate({start, end});
+      }
+
+      for (auto FSUs = 1u; FSUs <= std::min<uint64_t>(FSUsPerLink, 80u);
+           ++FSUs) {
+        for (const auto& [policy, list] : policies) {
+          const auto expected = list(spectrum, FSUs);
+
+          for (const auto search :
+               {core::SpectrumSearch::Scalar, core::SpectrumSearch::AVX2,
+                core::SpectrumSearch::AVX512}) {
+            if (!core::IsSupported(search)) {
+              continue;
+            }
+
+            const auto start = core::FindFreeRun(spectrum.bitmap(), FSUs,
+                                                 policy, search);
+
+            ASSERT_EQ(start.has_value(), expected.has_value());
+
+            if (start.has_value()) {
+              ASSERT_EQ(start.value(), expected->first);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(Spectrum, AssignRebuildsSlices) {
+  core::Spectrum spectrum(100);
+
+  spectrum.allocate({0, 3});
+
+  spectrum.allocate({60, 70});
+
+  spectrum.allocate({99, 99});
+
+  core::Spectrum copy(100);
+
+  copy.allocate({10, 20});
+
+  copy.assign(spectrum.bitmap());
+
+  ASSERT_TRUE(std::ranges::equal(copy.available_slices(),
+                                  spectrum.available_slices()));
+
+  ASSERT_EQ(copy.Serialize(), spectrum.Serialize());
+}
+
+TEST(Spectrum, ContinuityEngineAllocatesOnEveryHop) {
+  constexpr uint64_t FSUsPerLink = 100u;
+
+  std::vector<core::Spectrum> carriers(3u, core::Spectrum(FSUsPerLink));
+
+  // Free on every hop: [10, 14], [40, 47] and [80, 89].
+  carriers[0].allocate({0, 9});
+
+  carriers[0].allocate({48, 79});
+
+  carriers[1].allocate({15, 39});
+
+  carriers[1].allocate({90, 99});
+
+  carriers[2].allocate({0, 9});
+
+  carriers[2].allocate({15, 39});
+
+  const std::vector<graph::EdgeId> links{0u, 1u, 2u};
+
+  const std::vector<std::pair<std::string, uint64_t>> expectations{
+      {"best-fit", 10u},
+      {"first-fit", 10u},
+      {"last-fit", 80u},
+      {"worst-fit", 80u},
+  };
+
+  for (const auto search :
+       {core::SpectrumSearch::List, core::SpectrumSearch::Scalar,
+        core::SpectrumSearch::AVX2, core::SpectrumSearch::AVX512}) {
+    if (!core::IsSupported(search)) {
+      continue;
+    }
+
+    core::ContinuityEngine continuity(FSUsPerLink, search);
+
+    for (const auto& [allocation, expected] : expectations) {
+      core::RequestType type{};
+
+      type.FSUs = 5u;
+
+      type.policy = core::SpectrumAllocatorFactory::Policy(allocation);
+
+      const auto slice = continuity.Allocate(carriers, links, type);
+
+      ASSERT_TRUE(slice.has_value());
+
+      ASSERT_EQ(slice->first, expected);
+
+      for (const auto link : links) {
+        ASSERT_TRUE(carriers[link].available_at(slice.value()));
+      }
+    }
+
+    core::RequestType type{};
+
+    type.FSUs = 11u;
+
+    type.policy = core::FitPolicy::First;
+
+    ASSERT_FALSE(continuity.Allocate(carriers, links, type).has_value());
+  }
+}
+
+TEST(Spectrum, ContinuityEngineSearchesLoneLinksInPlace) {
+  constexpr uint64_t FSUsPerLink = 200u;
+
+  std::vector<core::Spectrum> carriers(2u, core::Spectrum(FSUsPerLink));
+
+  for (auto start = 0u; start + 9u <= FSUsPerLink; start += 9u) {
+    carriers[1].allocate({start, start + start % 4u});
+  }
+
+  const std::vector<graph::EdgeId> links{1u};
+
+  for (const auto search :
+       {core::SpectrumSearch::List, core::SpectrumSearch::Scalar,
+        core::SpectrumSearch::AVX2, core::SpectrumSearch::AVX512}) {
+    if (!core::IsSupported(search)) {
+      continue;
+    }
+
+    for (const std::string allocation :
+         {"best-fit", "first-fit", "last-fit", "random-fit", "worst-fit"}) {
+      // Equally seeded streams, so random-fit must draw the same run.
+      prng::Engine engine(prng::Engine::Type::Xoshiro, 41u, 0u);
+
+      prng::Engine reference(prng::Engine::Type::Xoshiro, 41u, 0u);
+
+      core::RequestType type{};
+
+      type.policy = core::SpectrumAllocatorFactory::Policy(allocation);
+
+      core::ContinuityEngine continuity(
+          FSUsPerLink, search,
+          {core::SpectrumAllocatorFactory::CreateAllocator(allocation, engine,
+                                                           search)});
+
+      const auto expected = core::SpectrumAllocatorFactory::CreateAllocator(
+          allocation, reference, core::SpectrumSearch::List);
+
+      for (const auto FSUs : {1u, 4u, 6u, 9u}) {
+        type.FSUs = FSUs;
+
+        ASSERT_EQ(continuity.Allocate(carriers, links, type),
+                  expected(carriers[1], FSUs))
+            << allocation << " " << FSUs;
+      }
+    }
+  }
+}
+
 TEST(Spectrum, ExternalFragmentation) {
   core::Spectrum spectrum(10);
 
@@ -154,3 +492,157 @@ TEST(Spectrum, AbsoluteFragmentation) {
 
   EXPECT_NEAR(expected, (*fn)(spectrum), absolute_error);
 }
+
+TEST(Spectrum, LinkSumMatchesRecomputation) {
+  prng::Engine engine(prng::Engine::Type::Xoshiro, 43u, 0u);
+
+  constexpr auto Saturation = std::numeric_limits<double>::max();
+
+  std::vector<double> terms(64u, 0.0);
+
+  core::LinkSum total;
+
+  for (auto round = 0u; round < 10000u; ++round) {
+    const auto link = engine.Below(terms.size());
+
+    const auto term = static_cast<double>(engine.Below(1u << 20u)) / 1e5;
+
+    total.replace(terms[link], term);
+
+    terms[link] = term;
+
+    ASSERT_NEAR(total.value(),
+                std::accumulate(terms.begin(), terms.end(), 0.0), 1e-6);
+  }
+
+  // Saturated terms saturate the total as a plain sum would, and leave it
+  // exact again once they are replaced.
+  const auto finite = total.value();
+
+  total.replace(terms[0], Saturation);
+
+  ASSERT_EQ(total.value(), Saturation);
+
+  total.replace(terms[1], Saturation);
+
+  ASSERT_TRUE(std::isinf(total.value()));
+
+  total.replace(Saturation, terms[0]);
+
+  total.replace(Saturation, terms[1]);
+
+  ASSERT_EQ(total.value(), finite);
+
+  total.clear();
+
+  ASSERT_EQ(total.value(), 0.0);
+}
+
+TEST(Spectrum, IndexTracksSlices) {
+  prng::Engine engine(prng::Engine::Type::Xoshiro, 31u, 0u);
+
+  core::Spectrum spectrum(200);
+
+  std::vector<core::Slice> allocations;
+
+  const auto check = [&]() {
+    const auto slices = spectrum.available_slices();
+
+    uint64_t available = 0u;
+
+    uint64_t largest = 0u;
+
+    auto entropy = 0.0;
+
+    for (const auto& slice : slices) {
+      const auto ratio = core::size(slice) / 200.0;
+
+      available += core::size(slice);
+
+      largest = std::max(largest, core::size(slice));
+
+      if (core::size(slice) >= 3u) {
+        entropy -= ratio * std::log(ratio);
+      }
+    }
+
+    ASSERT_EQ(spectrum.available(), available);
+
+    ASSERT_EQ(spectrum.largest_available(), largest);
+
+    ASSERT_NEAR(spectrum.entropy(3u), entropy, 1e-9);
+
+    for (auto FSUs = 1u; FSUs <= 12u; ++FSUs) {
+      const auto fits = [&](const core::Slice& slice) {
+        return core::size(slice) >= FSUs;
+      };
+
+      const auto first = std::ranges::find_if(slices, fits);
+
+      const auto last = std::ranges::find_if(slices | std::views::reverse, fits);
+
+      std::optional<core::Slice> smallest;
+
+      for (const auto& slice : slices | std::views::filter(fits)) {
+        if (!smallest || core::size(slice) < core::size(smallest.value())) {
+          smallest = slice;
+        }
+      }
+
+      ASSERT_EQ(spectrum.first_available(FSUs).has_value(),
+                first != slices.end());
+
+      if (first == slices.end()) {
+        continue;
+      }
+
+      ASSERT_EQ(spectrum.first_available(FSUs).value(), *first);
+
+      ASSERT_EQ(spectrum.last_available(FSUs).value(), *last);
+
+      ASSERT_EQ(spectrum.smallest_available(FSUs), smallest);
+    }
+  };
+
+  for (auto round = 0u; round < 2000u; ++round) {
+    if (!allocations.empty() && engine() % 3u == 0u) {
+      const auto index = engine() % allocations.size();
+
+      spectrum.deallocate(allocations[index]);
+
+      allocations.erase(allocations.begin() + index);
+    } else {
+      const auto start = engine() % 200u;
+
+      const core::Slice slice(start, std::min<uint64_t>(199u, start + engine() % 9u));
+
+      if (spectrum.available_at(slice)) {
+        spectrum.allocate(slice);
+
+        allocations.push_back(slice);
+      }
+    }
+
+    check();
+
+    if (round % 100u == 0u && spectrum.available_at({0u, 0u})) {
+      spectrum.begin_transaction();
+
+      spectrum.allocate({0u, 0u});
+
+      spectrum.rollback();
+
+      check();
+    }
+  }
+
+  core::Spectrum copy(200);
+
+  copy.assign(spectrum.bitmap());
+
+  ASSERT_EQ(copy.available(), spectrum.available());
+
+  ASSERT_EQ(copy.largest_available(), spectrum.largest_available());
+
+  ASSERT_EQ(copy.entropy(1u), spectrum.entropy(1u));
+}